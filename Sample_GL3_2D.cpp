@@ -1,39 +1,84 @@
 #include <iostream>
 #include <cmath>
 #include <fstream>
+#include <iterator>
 #include <vector>
 #include <time.h>
 #include <stdlib.h>
-#include <glad/glad.h>
+#include <stdarg.h>
+#include "glloader.h"
 #include <GLFW/glfw3.h>
 #include <math.h>
+#include <string.h>
+#include <chrono>
 
 #define GLM_FORCE_RADIANS
 #include <glm/glm.hpp>
 #include <glm/gtx/transform.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "world.h"
+#include "collide.h"
+#include "batch.h"
+#include "glstate.h"
+#include "vertex.h"
+#include "log.h"
+#include "profile.h"
+#include "gputimer.h"
+#include "replay.h"
+#include "headless.h"
+#include "shadercache.h"
+#include "shaderwatch.h"
+#include "trace.h"
+#include "shaders.h" // generated by make from the .vert and .frag files
+
 using namespace std;
 float left_move = 0;
-glm::vec3 b1_pos, b2_pos, rect_pos;
+World world;
+double tick_rate = 60; // simulation steps per second
+bool show_batch_stats = false; // print the sprite batch's numbers once a second
+double score_rate = 10; // most score lines per second, 0 for every change
+const char *profile_path = "profile.csv"; // where P writes the frame profile
+bool profile_on_exit = false;
+const char *startup_trace_path = NULL; // --startup-trace: where the startup timeline goes
+InputRecorder recorder; // only writes once opened by --record
+
+/* Apply player input to the world, recording it if a recording is on */
+void input (InputKind kind, double value)
+{
+    InputEvent e = { world.tick, (uint8_t)kind, value };
+    recorder.record(e);
+    applyInput(world, e);
+}
+
+/* Write the per-phase frame timings out as CSV */
+void writeProfile ()
+{
+    if (profiler.writeCSV(profile_path))
+        gameLog.printf("Frame profile written to %s\n", profile_path);
+    else
+        gameLog.printf("Could not write frame profile to %s\n", profile_path);
+    // Frames missing from the gpu.* rows; many means the query ring is too shallow
+    gameLog.printf("GPU timer: %d of %d frames dropped, not ready after %d frames\n",
+                   gpuTimer.dropped, gpuTimer.frame, GPU_QUERY_FRAMES);
+}
+
+/* The first frame is out: stop tracing startup and write the timeline
+   if --startup-trace asked for it */
+void finishStartupTrace (double firstFrameStart)
+{
+    startupTrace.add("first frame", firstFrameStart);
+    startupTrace.finish();
+    if (!startup_trace_path)
+        return;
+    if (startupTrace.writeJSON(startup_trace_path))
+        gameLog.printf("Startup trace written to %s\n", startup_trace_path);
+    else
+        gameLog.printf("Could not write startup trace to %s\n", startup_trace_path);
+}
 double xpos, ypos, xposGun, yposGun;
-double angleTan, angleTanGun;
 float triangle_rotation = 0;
-float bulletStatus=0;
-int bulletindex=-1;
-float score=0;
-double bullet_time, current_time;
-struct VAO {
-    GLuint VertexArrayID;
-    GLuint VertexBuffer;
-    GLuint ColorBuffer;
-
-    GLenum PrimitiveMode;
-    GLenum FillMode;
-    int NumVertices;
-};
-typedef struct VAO VAO;
-
+double current_time;
 struct GLMatrices {
 	glm::mat4 projection;
 	glm::mat4 model;
@@ -42,38 +87,74 @@ struct GLMatrices {
 } Matrices;
 GLuint programID;
 /* Function to load Shaders - Use it as it is */
-GLuint LoadShaders(const char * vertex_file_path,const char * fragment_file_path) {
+/* Whole file in one read; empty if it can't be opened */
+std::string readFile(const char * path) {
+	std::ifstream Stream(path, std::ios::in | std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(Stream), std::istreambuf_iterator<char>());
+}
+
+/* The copy of a shader built into the executable. Setting
+   FALLING_BLOCKS_SHADER_DIR loads it from that directory instead, to try
+   shader edits without a rebuild */
+std::string shaderSource(const char * name) {
+	const char * dir = getenv("FALLING_BLOCKS_SHADER_DIR");
+	if(dir)
+		return readFile((std::string(dir) + "/" + name).c_str());
+	for(size_t i = 0; i < sizeof(embeddedShaders)/sizeof(embeddedShaders[0]); i++)
+		if(!strcmp(embeddedShaders[i].name, name))
+			return embeddedShaders[i].source;
+	return "";
+}
+
+/* Shader build output. At startup it goes straight to stdout; once the
+   log thread is running (a hot reload) it goes through that a line at a
+   time, so the frame never waits on stdout */
+void shaderMessage(const char * fmt, ...) {
+	va_list args, copy;
+	va_start(args, fmt);
+	va_copy(copy, args);
+	std::vector<char> Text(max(vsnprintf(NULL, 0, fmt, copy), 0) + 1);
+	va_end(copy);
+	vsnprintf(&Text[0], Text.size(), fmt, args);
+	va_end(args);
+	if(!gameLog.running) {
+		fputs(&Text[0], stdout);
+		return;
+	}
+	for(const char * Line = &Text[0]; *Line; ) {
+		const char * End = strchr(Line, '\n');
+		int Length = End ? End - Line : strlen(Line);
+		gameLog.printf("%.*s\n", Length, Line);
+		Line += End ? Length + 1 : Length;
+	}
+}
+
+/* Compile and link a program from source; the paths only name the
+   shaders in messages. Returns 0 if it doesn't link */
+GLuint BuildProgram(const char * vertex_file_path, const std::string & VertexShaderCode,
+                    const char * fragment_file_path, const std::string & FragmentShaderCode) {
+
+	// A program linked by an earlier run, if the sources and driver match
+	TraceTimer Trace;
+	ShaderCache Cache;
+	Cache.init();
+	uint64_t CacheKey = Cache.key(VertexShaderCode, FragmentShaderCode);
+	GLuint CachedProgramID = Cache.load(CacheKey);
+	Trace.lap("shader cache load");
+	if(CachedProgramID) {
+		shaderMessage("Loaded program from %s\n", Cache.path.c_str());
+		return CachedProgramID;
+	}
 
 	// Create the shaders
 	GLuint VertexShaderID = glCreateShader(GL_VERTEX_SHADER);
 	GLuint FragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
 
-	// Read the Vertex Shader code from the file
-	std::string VertexShaderCode;
-	std::ifstream VertexShaderStream(vertex_file_path, std::ios::in);
-	if(VertexShaderStream.is_open())
-	{
-		std::string Line = "";
-		while(getline(VertexShaderStream, Line))
-			VertexShaderCode += "\n" + Line;
-		VertexShaderStream.close();
-	}
-
-	// Read the Fragment Shader code from the file
-	std::string FragmentShaderCode;
-	std::ifstream FragmentShaderStream(fragment_file_path, std::ios::in);
-	if(FragmentShaderStream.is_open()){
-		std::string Line = "";
-		while(getline(FragmentShaderStream, Line))
-			FragmentShaderCode += "\n" + Line;
-		FragmentShaderStream.close();
-	}
-
 	GLint Result = GL_FALSE;
 	int InfoLogLength;
 
 	// Compile Vertex Shader
-	printf("Compiling shader : %s\n", vertex_file_path);
+	shaderMessage("Compiling shader : %s\n", vertex_file_path);
 	char const * VertexSourcePointer = VertexShaderCode.c_str();
 	glShaderSource(VertexShaderID, 1, &VertexSourcePointer , NULL);
 	glCompileShader(VertexShaderID);
@@ -81,12 +162,15 @@ GLuint LoadShaders(const char * vertex_file_path,const char * fragment_file_path
 	// Check Vertex Shader
 	glGetShaderiv(VertexShaderID, GL_COMPILE_STATUS, &Result);
 	glGetShaderiv(VertexShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-	std::vector<char> VertexShaderErrorMessage(InfoLogLength);
-	glGetShaderInfoLog(VertexShaderID, InfoLogLength, NULL, &VertexShaderErrorMessage[0]);
-	fprintf(stdout, "%s\n", &VertexShaderErrorMessage[0]);
+	if(InfoLogLength > 1) { // the length counts the terminating NUL
+		std::vector<char> VertexShaderErrorMessage(InfoLogLength);
+		glGetShaderInfoLog(VertexShaderID, InfoLogLength, NULL, &VertexShaderErrorMessage[0]);
+		shaderMessage("%s\n", &VertexShaderErrorMessage[0]);
+	}
+	Trace.lap("compile vertex shader");
 
 	// Compile Fragment Shader
-	printf("Compiling shader : %s\n", fragment_file_path);
+	shaderMessage("Compiling shader : %s\n", fragment_file_path);
 	char const * FragmentSourcePointer = FragmentShaderCode.c_str();
 	glShaderSource(FragmentShaderID, 1, &FragmentSourcePointer , NULL);
 	glCompileShader(FragmentShaderID);
@@ -94,30 +178,69 @@ GLuint LoadShaders(const char * vertex_file_path,const char * fragment_file_path
 	// Check Fragment Shader
 	glGetShaderiv(FragmentShaderID, GL_COMPILE_STATUS, &Result);
 	glGetShaderiv(FragmentShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-	std::vector<char> FragmentShaderErrorMessage(InfoLogLength);
-	glGetShaderInfoLog(FragmentShaderID, InfoLogLength, NULL, &FragmentShaderErrorMessage[0]);
-	fprintf(stdout, "%s\n", &FragmentShaderErrorMessage[0]);
+	if(InfoLogLength > 1) {
+		std::vector<char> FragmentShaderErrorMessage(InfoLogLength);
+		glGetShaderInfoLog(FragmentShaderID, InfoLogLength, NULL, &FragmentShaderErrorMessage[0]);
+		shaderMessage("%s\n", &FragmentShaderErrorMessage[0]);
+	}
+	Trace.lap("compile fragment shader");
 
 	// Link the program
-	fprintf(stdout, "Linking program\n");
+	shaderMessage("Linking program\n");
 	GLuint ProgramID = glCreateProgram();
 	glAttachShader(ProgramID, VertexShaderID);
 	glAttachShader(ProgramID, FragmentShaderID);
+	Cache.prepare(ProgramID);
 	glLinkProgram(ProgramID);
 
 	// Check the program
 	glGetProgramiv(ProgramID, GL_LINK_STATUS, &Result);
 	glGetProgramiv(ProgramID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-	std::vector<char> ProgramErrorMessage( max(InfoLogLength, int(1)) );
-	glGetProgramInfoLog(ProgramID, InfoLogLength, NULL, &ProgramErrorMessage[0]);
-	fprintf(stdout, "%s\n", &ProgramErrorMessage[0]);
+	if(InfoLogLength > 1) {
+		std::vector<char> ProgramErrorMessage(InfoLogLength);
+		glGetProgramInfoLog(ProgramID, InfoLogLength, NULL, &ProgramErrorMessage[0]);
+		shaderMessage("%s\n", &ProgramErrorMessage[0]);
+	}
+	Trace.lap("link program");
+	if(Result == GL_TRUE)
+		Cache.save(ProgramID, CacheKey);
+	Trace.lap("shader cache save");
 
 	glDeleteShader(VertexShaderID);
 	glDeleteShader(FragmentShaderID);
 
+	if(Result != GL_TRUE) {
+		glDeleteProgram(ProgramID);
+		return 0;
+	}
 	return ProgramID;
 }
 
+GLuint LoadShaders(const char * vertex_file_path,const char * fragment_file_path) {
+	return BuildProgram(vertex_file_path, shaderSource(vertex_file_path),
+	                    fragment_file_path, shaderSource(fragment_file_path));
+}
+
+ShaderWatcher shaderWatcher; // only runs when shaders come from disk
+
+/* Swap in edited shaders, between frames. A version that doesn't build
+   leaves the old program running */
+void reloadShaders ()
+{
+	std::string VertexShaderCode, FragmentShaderCode;
+	if(!shaderWatcher.poll(VertexShaderCode, FragmentShaderCode))
+		return;
+	GLuint ProgramID = BuildProgram("Sample_GL.vert", VertexShaderCode, "Sample_GL.frag", FragmentShaderCode);
+	if(!ProgramID) {
+		gameLog.printf("Shader reload failed, keeping the old program\n");
+		return;
+	}
+	glDeleteProgram(programID);
+	programID = ProgramID;
+	Matrices.MatrixID = glGetUniformLocation(programID, "MVP");
+	gameLog.printf("Shaders reloaded\n");
+}
+
 static void error_callback(int error, const char* description)
 {
     fprintf(stderr, "Error: %s\n", description);
@@ -125,87 +248,18 @@ static void error_callback(int error, const char* description)
 
 void quit(GLFWwindow *window)
 {
+    if (profile_on_exit)
+        writeProfile();
+    recorder.close(world.tick);
+    gameLog.stop();
     glfwDestroyWindow(window);
     glfwTerminate();
     exit(EXIT_SUCCESS);
 }
 
 
-/* Generate VAO, VBOs and return VAO handle */
-struct VAO* create3DObject (GLenum primitive_mode, int numVertices, const GLfloat* vertex_buffer_data, const GLfloat* color_buffer_data, GLenum fill_mode=GL_FILL)
-{
-    struct VAO* vao = new struct VAO;
-    vao->PrimitiveMode = primitive_mode;
-    vao->NumVertices = numVertices;
-    vao->FillMode = fill_mode;
-
-    // Create Vertex Array Object
-    // Should be done after CreateWindow and before any other GL calls
-    glGenVertexArrays(1, &(vao->VertexArrayID)); // VAO
-    glGenBuffers (1, &(vao->VertexBuffer)); // VBO - vertices
-    glGenBuffers (1, &(vao->ColorBuffer));  // VBO - colors
-
-    glBindVertexArray (vao->VertexArrayID); // Bind the VAO
-    glBindBuffer (GL_ARRAY_BUFFER, vao->VertexBuffer); // Bind the VBO vertices
-    glBufferData (GL_ARRAY_BUFFER, 3*numVertices*sizeof(GLfloat), vertex_buffer_data, GL_STATIC_DRAW); // Copy the vertices into VBO
-    glVertexAttribPointer(
-                          0,                  // attribute 0. Vertices
-                          3,                  // size (x,y,z)
-                          GL_FLOAT,           // type
-                          GL_FALSE,           // normalized?
-                          0,                  // stride
-                          (void*)0            // array buffer offset
-                          );
-
-    glBindBuffer (GL_ARRAY_BUFFER, vao->ColorBuffer); // Bind the VBO colors
-    glBufferData (GL_ARRAY_BUFFER, 3*numVertices*sizeof(GLfloat), color_buffer_data, GL_STATIC_DRAW);  // Copy the vertex colors
-    glVertexAttribPointer(
-                          1,                  // attribute 1. Color
-                          3,                  // size (r,g,b)
-                          GL_FLOAT,           // type
-                          GL_FALSE,           // normalized?
-                          0,                  // stride
-                          (void*)0            // array buffer offset
-                          );
-
-    return vao;
-}
-
-/* Generate VAO, VBOs and return VAO handle - Common Color for all vertices */
-struct VAO* create3DObject (GLenum primitive_mode, int numVertices, const GLfloat* vertex_buffer_data, const GLfloat red, const GLfloat green, const GLfloat blue, GLenum fill_mode=GL_FILL)
-{
-    GLfloat* color_buffer_data = new GLfloat [3*numVertices];
-    for (int i=0; i<numVertices; i++) {
-        color_buffer_data [3*i] = red;
-        color_buffer_data [3*i + 1] = green;
-        color_buffer_data [3*i + 2] = blue;
-    }
-
-    return create3DObject(primitive_mode, numVertices, vertex_buffer_data, color_buffer_data, fill_mode);
-}
-
-/* Render the VBOs handled by VAO */
-void draw3DObject (struct VAO* vao)
-{
-    // Change the Fill Mode for this object
-    glPolygonMode (GL_FRONT_AND_BACK, vao->FillMode);
-
-    // Bind the VAO to use
-    glBindVertexArray (vao->VertexArrayID);
-
-    // Enable Vertex Attribute 0 - 3d Vertices
-    glEnableVertexAttribArray(0);
-    // Bind the VBO to use
-    glBindBuffer(GL_ARRAY_BUFFER, vao->VertexBuffer);
-
-    // Enable Vertex Attribute 1 - Color
-    glEnableVertexAttribArray(1);
-    // Bind the VBO to use
-    glBindBuffer(GL_ARRAY_BUFFER, vao->ColorBuffer);
-
-    // Draw the geometry !
-    glDrawArrays(vao->PrimitiveMode, 0, vao->NumVertices); // Starting from vertex 0; 3 vertices total -> 1 triangle
-}
+/* The frame's objects are drawn through one sprite batch */
+SpriteBatch batch;
 
 /**************************
  * Customizable functions *
@@ -239,8 +293,11 @@ void keyboard (GLFWwindow* window, int key, int scancode, int action, int mods)
     if (action == GLFW_PRESS) {
                 switch(key){
                   case GLFW_KEY_SPACE:
-                  angleTanGun = atan(yposGun/xposGun);
-                  bulletStatus = 1;
+                  input(INPUT_FIRE, atan(yposGun/xposGun));
+                  break;
+                case GLFW_KEY_P:
+                  writeProfile();
+                  break;
                 default:
                   break;
                 }
@@ -248,47 +305,24 @@ void keyboard (GLFWwindow* window, int key, int scancode, int action, int mods)
     if(glfwGetKey(window, GLFW_KEY_LEFT_SHIFT))
       {
         if(glfwGetKey(window, GLFW_KEY_LEFT))
-        {
-        if(b2_pos.x>-2.8)
-        {
-          b2_pos.x -= 0.2;
-        }
-        }
+          input(INPUT_BASKET2, -0.2);
         else if(glfwGetKey(window, GLFW_KEY_RIGHT))
-        {
-          if(b2_pos.x<1.8)
-          {
-          b2_pos.x += 0.2;
-        }
-        }
+          input(INPUT_BASKET2, 0.2);
       }
       if(glfwGetKey(window, GLFW_KEY_LEFT_ALT))
         {
           if(glfwGetKey(window, GLFW_KEY_LEFT))
-          {
-          if(b1_pos.x>-2.8)
-          {
-            b1_pos.x -= 0.2;
-          }
-          }
+            input(INPUT_BASKET1, -0.2);
           else if(glfwGetKey(window, GLFW_KEY_RIGHT))
-          {
-            if(b1_pos.x<2.8)
-            {
-            b1_pos.x += 0.2;
-          }
-          }
+            input(INPUT_BASKET1, 0.2);
         }
         if(glfwGetKey(window, GLFW_KEY_F))
           {
-              if(rect_pos.y>-1)
-              rect_pos.y -= 0.2;
-
+              input(INPUT_TURRET, -0.2);
           }
           if(glfwGetKey(window, GLFW_KEY_S))
             {
-                if(rect_pos.y<2.2)
-                rect_pos.y += 0.2;
+                input(INPUT_TURRET, 0.2);
             }
             if(glfwGetKey(window, GLFW_KEY_A))
               {
@@ -347,9 +381,9 @@ void reshapeWindow (GLFWwindow* window, int width, int height)
     int fbwidth=width, fbheight=height;
     /* With Retina display on Mac OS X, GLFW's FramebufferSize
      is different from WindowSize */
-    glfwGetFramebufferSize(window, &fbwidth, &fbheight);
-
-	GLfloat fov = 90.0f;
+    if (window) { // no window when rendering headless
+        glfwGetFramebufferSize(window, &fbwidth, &fbheight);
+    }
 
 	// sets the viewport of openGL renderer
 	glViewport (0, 0, (GLsizei) fbwidth, (GLsizei) fbheight);
@@ -360,444 +394,80 @@ void reshapeWindow (GLFWwindow* window, int width, int height)
 	   gluPerspective (fov, (GLfloat) fbwidth / (GLfloat) fbheight, 0.1, 500.0); */
 	// Store the projection matrix in a variable for future use
     // Perspective projection for 3D views
+    // GLfloat fov = 90.0f;
     // Matrices.projection = glm::perspective (fov, (GLfloat) fbwidth / (GLfloat) fbheight, 0.1f, 500.0f);
 
     // Ortho projection for 2D views
     Matrices.projection = glm::ortho(-4.0f, 4.0f, -4.0f, 4.0f, 0.1f, 500.0f);
 }
 /* Variable declarations are here*/
-VAO *rectangle;
-VAO *gun;
-VAO *base;
-VAO *basket1;
-VAO *basket2;
-VAO *mirror;
-//VAO *greenBrick;
-VAO *greenBrick;
-VAO *redBrick;
-VAO *blackBrick;
-VAO *bullet;
-int greenBrickIndex = 0, redBrickIndex = 0, blackBrickIndex = 0;
-float randaf,randafred,randafblack;
-float greenx[1000];
-float greeny[1000];
-float greenrand[1000];
-float redx[1000];
-float redy[1000];
-float redrand[1000];
-float blackx[1000];
-float blacky[1000];
-float bulletx[100];
-float bullety[100];
-double bulletrot[100];
-float time_now,time_before, time_beforered, time_beforeblack;
-int indexc = 0,indexred = 0, indexblack =  0;
-float gbx = 2.5;
-
-bool chckcollision(float ax,float bx, float ay, float by, float aw, float bw, float ah, float bh)
-{
-	return fabs(ax - bx) < (aw + bw)/2 && fabs(ay - by) < (ah + bh)/2;
-}
-void createblackBrick()
-{
-  // GL3 accepts only Triangles. Quads are not supported
-  /*static const GLfloat vertex_buffer_data [] = {
-    -1.2,-1,0, // vertex 1
-    1.2,-1,0, // vertex 2
-    1.2, 1,0, // vertex 3
-
-    1.2, 1,0, // vertex 3
-    -1.2, 1,0, // vertex 4
-    -1.2,-1,0  // vertex 1
-
-
-  };*/
-  static const GLfloat vertex_buffer_data [] = {
-    0,0,0, // vertex 1
-    0.3,0,0, // vertex 2
-    0,0.4,0,// vertex 3
-
-    0.3, 0,0, // vertex 3
-    0.3, 0.4,0, // vertex 4
-    0,0,0,  // vertex 1
-  };
-  static const GLfloat color_buffer_data [] = {
-    0,0,0, // color 1
-    0,0,0, // color 2
-    0,0,0, // color 3
-
-    0,0,0, // color 3
-    0,0,0, // color 4
-    0,0,0,  // color 1*/
-  };
-//  for(int i=0;i<1000;i++)
-  blackBrick = create3DObject(GL_TRIANGLES, 6, vertex_buffer_data, color_buffer_data, GL_FILL);
-}
-void createBullet()
-{
-  // GL3 accepts only Triangles. Quads are not supported
-  /*static const GLfloat vertex_buffer_data [] = {
-    -1.2,-1,0, // vertex 1
-    1.2,-1,0, // vertex 2
-    1.2, 1,0, // vertex 3
-
-    1.2, 1,0, // vertex 3
-    -1.2, 1,0, // vertex 4
-    -1.2,-1,0  // vertex 1
-
-
-  };*/
-  static const GLfloat vertex_buffer_data [] = {
-    0,0.07,0, // vertex 1
-    0,0,0, // vertex 2
-    0.15,0,0,// vertex 3
-
-    0, 0.07,0, // vertex 3
-    0.15, 0,0, // vertex 4
-    0.15,0.07,0  // vertex 1
-  };
-  static const GLfloat color_buffer_data [] = {
-    1,1,0, // color 1
-    1,1,0, // color 2
-    1,1,0, // color 3
-
-    1,1,0, // color 3
-    1,1,0, // color 4
-    1,1,0,  // color 1*/
-  };
-  //for(int i=0;i<100;i++)
-  bullet = create3DObject(GL_TRIANGLES, 6, vertex_buffer_data, color_buffer_data, GL_FILL);
-}
-void creategreenBrick()
-{
-  // GL3 accepts only Triangles. Quads are not supported
-  /*static const GLfloat vertex_buffer_data [] = {
-    -1.2,-1,0, // vertex 1
-    1.2,-1,0, // vertex 2
-    1.2, 1,0, // vertex 3
-
-    1.2, 1,0, // vertex 3
-    -1.2, 1,0, // vertex 4
-    -1.2,-1,0  // vertex 1
-
-
-  };*/
-  static const GLfloat vertex_buffer_data [] = {
-    0,0,0, // vertex 1
-    0.3,0,0, // vertex 2
-    0,0.4,0,// vertex 3
-
-    0.3, 0,0, // vertex 3
-    0.3, 0.4,0, // vertex 4
-    0,0,0,  // vertex 1
-  };
-  static const GLfloat color_buffer_data [] = {
-    0,1,0, // color 1
-    0,1,0, // color 2
-    0,1,0, // color 3
-
-    0,1,0, // color 3
-    0,1,0, // color 4
-    0,1,0  // color 1*/
-  };
-
-  // create3DObject creates and returns a handle to a VAO that can be used later
-//  for(int i=0;i<1000;i++)
-  greenBrick = create3DObject(GL_TRIANGLES, 6, vertex_buffer_data, color_buffer_data, GL_FILL);
-}
-void createredBrick()
-{
-  // GL3 accepts only Triangles. Quads are not supported
-  /*static const GLfloat vertex_buffer_data [] = {
-    -1.2,-1,0, // vertex 1
-    1.2,-1,0, // vertex 2
-    1.2, 1,0, // vertex 3
-
-    1.2, 1,0, // vertex 3
-    -1.2, 1,0, // vertex 4
-    -1.2,-1,0  // vertex 1
-
-
-  };*/
-  static const GLfloat vertex_buffer_data [] = {
-    0,0,0, // vertex 1
-    0.3,0,0, // vertex 2
-    0,0.4,0,// vertex 3
-
-    0.3, 0,0, // vertex 3
-    0.3, 0.4,0, // vertex 4
-    0,0,0,  // vertex 1
-  };
-  static const GLfloat color_buffer_data [] = {
-    1,0,0, // color 1
-    1,0,0, // color 2
-    1,0,0, // color 3
-
-    1,0,0, // color 3
-    1,0,0, // color 4
-    1,0,0  // color 1*/
-  };
-
-  // create3DObject creates and returns a handle to a VAO that can be used later
-  //for(int i=0;i<1000;i++)
-  redBrick = create3DObject(GL_TRIANGLES, 6, vertex_buffer_data, color_buffer_data, GL_FILL);
-}
-void createBasket2 ()
-{
-  // GL3 accepts only Triangles. Quads are not supported
-  /*static const GLfloat vertex_buffer_data [] = {
-    -1.2,-1,0, // vertex 1
-    1.2,-1,0, // vertex 2
-    1.2, 1,0, // vertex 3
-
-    1.2, 1,0, // vertex 3
-    -1.2, 1,0, // vertex 4
-    -1.2,-1,0  // vertex 1
-
-
-  };*/
-  static const GLfloat vertex_buffer_data [] = {
-  /*  2.5,-3.6,0, // vertex 1
-    1.8,-3.6,0, // vertex 2
-    2.5,-2.6,0,// vertex 3
-
-    2.5, -2.6,0, // vertex 3
-    1.8, -3.6,0, // vertex 4
-    1.8,-2.6,0  // vertex 1*/
-    0,0,0,
-    0.7,0,0,
-    0.7,1,0,
-
-    0,1,0,
-    0.7,1,0,
-    0,0,0,
-  };
-
-  static const GLfloat color_buffer_data [] = {
-    0,1,0, // color 1
-    0,1,0, // color 2
-    0,1,0, // color 3
-
-    0,1,0, // color 3
-    0,1,0, // color 4
-    0,1,0  // color 1*/
-  };
-
-  // create3DObject creates and returns a handle to a VAO that can be used later
-  basket2 = create3DObject(GL_TRIANGLES, 6, vertex_buffer_data, color_buffer_data, GL_FILL);
-}
-void createBasket1 ()
-{
-  // GL3 accepts only Triangles. Quads are not supported
-  /*static const GLfloat vertex_buffer_data [] = {
-    -1.2,-1,0, // vertex 1
-    1.2,-1,0, // vertex 2
-    1.2, 1,0, // vertex 3
-
-    1.2, 1,0, // vertex 3
-    -1.2, 1,0, // vertex 4
-    -1.2,-1,0  // vertex 1
-
-
-  };*/
-  static const GLfloat vertex_buffer_data [] = {
-    0,0,0,
-    0.7,0,0,
-    0.7,1,0,
-
-    0,1,0,
-    0.7,1,0,
-    0,0,0,  // vertex 1
-  };
-  static const GLfloat color_buffer_data [] = {
-    1,0,0, // color 1
-    1,0,0, // color 2
-    1,0,0, // color 3
-
-    1,0,0, // color 3
-    1,0,0, // color 4
-    1,0,0  // color 1*/
-  };
-
-  // create3DObject creates and returns a handle to a VAO that can be used later
-  basket1 = create3DObject(GL_TRIANGLES, 6, vertex_buffer_data, color_buffer_data, GL_FILL);
-}
-void createBase ()
-{
-  // GL3 accepts only Triangles. Quads are not supported
-  /*static const GLfloat vertex_buffer_data [] = {
-    -1.2,-1,0, // vertex 1
-    1.2,-1,0, // vertex 2
-    1.2, 1,0, // vertex 3
-
-    1.2, 1,0, // vertex 3
-    -1.2, 1,0, // vertex 4
-    -1.2,-1,0  // vertex 1
-
-
-  };*/
-  static const GLfloat vertex_buffer_data [] = {
-    /*-4,-3,0, // vertex 1
-    4,-3,0, // vertex 2
-    -4,-4,0,// vertex 3
-
-    -4, -4,0, // vertex 3
-    4, -4,0, // vertex 4
-    4,-3,0  // vertex 1*/
-    0,0,0,
-    8,0,0,
-    8,1,0,
-
-    0,0,0,
-    0,1,0,
-    8,1,0,
-  };
-  static const GLfloat color_buffer_data [] = {
-    0,0,0, // color 1
-    0,0,0, // color 2
-    0,0,0, // color 3
-
-    0,0,0, // color 3
-    0,0,0, // color 4
-    0,0,0  // color 1*/
-  };
-
-  // create3DObject creates and returns a handle to a VAO that can be used later
-  base = create3DObject(GL_TRIANGLES, 6, vertex_buffer_data, color_buffer_data, GL_FILL);
-}
-void createGun ()
-{
-  // GL3 accepts only Triangles. Quads are not supported
-  /*static const GLfloat vertex_buffer_data [] = {
-    -1.2,-1,0, // vertex 1
-    1.2,-1,0, // vertex 2
-    1.2, 1,0, // vertex 3
-
-    1.2, 1,0, // vertex 3
-    -1.2, 1,0, // vertex 4
-    -1.2,-1,0  // vertex 1
-
-
-  };*/
-  static const GLfloat vertex_buffer_data [] = {
-  /*  0.75,0.15,0, // vertex 1
-    0,0.15,0, // vertex 2
-    0.75,-0.15,0,// vertex 3
-
-    0.75, -0.15,0, // vertex 3
-    0, -0.15,0, // vertex 4
-    0,0.15,0  // vertex 1*/
-    0,0,0,
-    0.75,0,0,
-    0,0.4,0,
-
-    0,0.4,0,
-    0.75,0,0,
-    0.75,0.4,0,
-  };
-  static const GLfloat color_buffer_data [] = {
-    0,0,0, // color 1
-    0,0,0, // color 2
-    0,0,0, // color 3
-
-    0,0,0, // color 3
-    0,0,0, // color 4
-    0,0,0, // color 1*/
-  };
-
-  // create3DObject creates and returns a handle to a VAO that can be used later
-  gun = create3DObject(GL_TRIANGLES, 6, vertex_buffer_data, color_buffer_data, GL_FILL);
+Sprite rectangle;
+Sprite gun;
+Sprite base;
+Sprite basket1;
+Sprite basket2;
+Sprite mirror;
+Sprite greenBrick;
+Sprite redBrick;
+Sprite blackBrick;
+Sprite bullet;
+
+/* A w x h sprite of a shared mesh, placed by its bottom-left corner */
+Sprite createSprite (const PackedVertex *mesh, int numVertices, float w, float h, float red, float green, float blue)
+{
+  Sprite sprite;
+  sprite.mesh = mesh;
+  sprite.numVertices = numVertices;
+  sprite.fillMode = GL_FILL;
+  sprite.w = w;
+  sprite.h = h;
+  sprite.pivotx = sprite.pivoty = 0;
+  sprite.r = packColor(red);
+  sprite.g = packColor(green);
+  sprite.b = packColor(blue);
+  return sprite;
+}
+
+/* Everything in the scene is the unit quad at some size and colour,
+   apart from the mirror which is half of one */
+void createSprites ()
+{
+  rectangle  = createSprite(unitQuad, 6, 0.5, 1, 0,0,0);
+  gun        = createSprite(unitQuad, 6, 0.75, 0.4, 0,0,0);
+  base       = createSprite(unitQuad, 6, 8, 1, 0,0,0);
+  basket1    = createSprite(unitQuad, 6, 0.7, 1, 1,0,0);
+  basket2    = createSprite(unitQuad, 6, 0.7, 1, 0,1,0);
+  mirror     = createSprite(unitTriangle, 3, 0.5, 0.5, 0,1,1);
+  redBrick   = createSprite(unitQuad, 6, 0.3, 0.4, 1,0,0);
+  greenBrick = createSprite(unitQuad, 6, 0.3, 0.4, 0,1,0);
+  blackBrick = createSprite(unitQuad, 6, 0.3, 0.4, 0,0,0);
+  bullet     = createSprite(unitQuad, 6, 0.15, 0.07, 1,1,0);
 }
 
-// Creates the triangle object used in this sample code
-// Creates the rectangle object used in this sample code
-void createRectangle ()
-{
-  // GL3 accepts only Triangles. Quads are not supported
-  /*static const GLfloat vertex_buffer_data [] = {
-    -1.2,-1,0, // vertex 1
-    1.2,-1,0, // vertex 2
-    1.2, 1,0, // vertex 3
-
-    1.2, 1,0, // vertex 3
-    -1.2, 1,0, // vertex 4
-    -1.2,-1,0  // vertex 1
-
-
-  };*/
-  static const GLfloat vertex_buffer_data [] = {
-    /*-4,0.5,0, // vertex 1
-    -3.5,0.5,0, // vertex 2
-    -4,-0.5,0,// vertex 3
-
-    -4, -0.5,0, // vertex 3
-    -3.5, -0.5,0, // vertex 4
-    -3.5,0.5,0  // vertex 1*/
-    0,0,0,
-    0.5,0,0,
-    0,1,0,
-
-    0,1,0,
-    0.5,0,0,
-    0.5,1,0,
-  };
-  static const GLfloat color_buffer_data [] = {
-    0,0,0, // color 1
-    0,0,0, // color 2
-    0,0,0, // color 3
-
-    0,0,0, // color 3
-    0,0,0, // color 4
-    0,0,0  // color 1*/
-  };
-
-  // create3DObject creates and returns a handle to a VAO that can be used later
-  rectangle = create3DObject(GL_TRIANGLES, 6, vertex_buffer_data, color_buffer_data, GL_FILL);
-}
-void createMirror ()
-{
-  // GL3 accepts only Triangles. Quads are not supported
-  /*static const GLfloat vertex_buffer_data [] = {
-    -1.2,-1,0, // vertex 1
-    1.2,-1,0, // vertex 2
-    1.2, 1,0, // vertex 3
-
-    1.2, 1,0, // vertex 3
-    -1.2, 1,0, // vertex 4
-    -1.2,-1,0  // vertex 1
-
-
-  };*/
-  static const GLfloat vertex_buffer_data [] = {
-    0,0,0,
-    0.5,0,0,
-    0.5,0.5,0,// vertex 1
-  };
-  static const GLfloat color_buffer_data [] = {
-    0,1,1, // color 1
-    0,1,1, // color 2
-    0,1,1, // color 3 // color 1*/
-  };
-
-  // create3DObject creates and returns a handle to a VAO that can be used later
-  mirror = create3DObject(GL_TRIANGLES, 6, vertex_buffer_data, color_buffer_data, GL_FILL);
-}
 float camera_rotation_angle = 90;
 float rectangle_rotation = 4;
 float rectangle_rot_dir = 1;
 bool rectangle_rot_status = true;
-/* Render the scene with openGL */
-/* Edit this function according to your assignment */
-void draw ()
+/* Blend a position from the previous simulation step into the current one */
+float lerp (float prev, float cur, float alpha)
 {
+  return prev + (cur - prev)*alpha;
+}
 
-cout<<"The score is "<<score<<endl;
+/* Render the scene with openGL */
+/* alpha is how far we are between the last two simulation steps */
+void draw (float alpha)
+{
+  ProfileTimer timer;
+  gpuTimer.beginFrame();
   // clear the color and depth in the frame buffer
   glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  gpuTimer.endPass(GPU_CLEAR);
 
   // use the loaded shader program
   // Don't change unless you know what you are doing
-  glUseProgram (programID);
+  glState.stats.issued = glState.stats.skipped = 0;
+  glState.useProgram (programID);
 
   // Eye - Location of camera. Don't change unless you are sure!!
   glm::vec3 eye ( 5*cos(camera_rotation_angle*M_PI/180.0f), 0, 5*sin(camera_rotation_angle*M_PI/180.0f) );
@@ -834,223 +504,37 @@ cout<<"The score is "<<score<<endl;
 
 
 
-  MVP = VP * Matrices.model;
-  glm::mat4 translateBase = glm::translate (glm::vec3(-4,-4,0));
-  Matrices.model *= translateBase;
-  MVP = VP * Matrices.model;
-  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-  draw3DObject(base);
-  Matrices.model = glm::mat4(1.0f);
-  glm::mat4 translateMirror = glm::translate(glm::vec3(2.5,0,0));
-  Matrices.model *= (translateMirror);
-  MVP = VP * Matrices.model;
-  for(int j=0;j<bulletindex;j++)
-  {
-      bool tryandl = chckcollision(2.5, bulletx[j], 0, bullety[j], 0.4, 0.15, 0.4, 0.07);
-      if(tryandl)
-      {
-        bulletrot[j] = bulletrot[j]*(M_PI);
-        cout<<"Reflect"<<endl;
-      }
-  }
-  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-  draw3DObject(mirror);
-  Matrices.model = glm::mat4(1.0f);
-  // draw3DObject draws the VAO given to it using current MVP matrix
-
-  /*glm::mat4 translateRectangle12 = glm::translate (rect_pos);        // glTranslatef
-  glm::mat4 rotateRectangle12 = glm::translate(rect_pos); // rotate about vector (-1,1,1)
-  Matrices.model *= (translateRectangle12 * rotateRectangle12);*/
-  glm::mat4 translateRectangle124 = glm::translate (rect_pos);
-  Matrices.model *= (translateRectangle124);
-  MVP = VP * Matrices.model;
-  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-  draw3DObject(rectangle);
-  Matrices.model = glm::mat4(1.0f);      // glTranslatef
-
-  glm::mat4 translateRectangle124n = glm::translate (glm::vec3(rect_pos.x+0.2,rect_pos.y+0.3,rect_pos.z));
-  glm::mat4 rotateRectangle12n = glm::rotate((float)(-angleTan+0.5), glm::vec3(glm::vec3(0,0,1))); // rotate about vector (-1,1,1)
-  Matrices.model *= (translateRectangle124n * rotateRectangle12n);
-  MVP = VP * Matrices.model;
-  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-  draw3DObject(gun);
-  Matrices.model = glm::mat4(1.0f);
-
-  glm::mat4 translateRectangle = glm::translate (b1_pos);
-  //cout<<"basket at "<<b1_pos.x<<" and "<<b1_pos.y<<endl;      // glTranslatef // rotate about vector (-1,1,1)
-  Matrices.model *= (translateRectangle);
+  // Everything is placed on the CPU and drawn in one go through the
+  // sprite batch, so the whole frame shares the VP matrix
   MVP = VP * Matrices.model;
   glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-  draw3DObject(basket1);
-  Matrices.model = glm::mat4(1.0f);
-  glm::mat4 translateRectangle1 = glm::translate (b2_pos);        // glTranslatef
-  Matrices.model *= (translateRectangle1 );
-  MVP = VP * Matrices.model;
-  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-  draw3DObject(basket2);
-  for (int i=0;i<(bulletindex);i++)
-  {
-  Matrices.model = glm::mat4(1.0f);
-  glm::mat4 translateRectangle = glm::translate (glm::vec3(bulletx[i],bullety[i], 0));        // glTranslatef
-  glm::mat4 bulletRotate = glm::rotate((float)(-bulletrot[i]+0.5), glm::vec3(0,0,1));
-  bulletx[i] = bulletx[i] + 0.1;
-  if (bulletx[i]>4)
-  bulletx[i] = 200;
-  bullety[i] = bullety[i] + ((cos(-bulletrot[i] - 1.085))/4);
-  Matrices.model *= (translateRectangle * bulletRotate);
-  MVP = VP * Matrices.model;
-  glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-  draw3DObject(bullet);
-  for(int j=0;j<blackBrickIndex;j++)
+  batch.begin();
+
+  batch.add(base, -4, -4, 0);
+  batch.add(mirror, world.mirror.x, world.mirror.y, 0);
+  batch.add(rectangle, world.turret.x, world.turret.y, 0);
+  batch.add(gun, world.turret.x+0.2, world.turret.y+0.3, -world.aim+0.5);
+  batch.add(basket1, world.basket1.x, world.basket1.y, 0);
+  batch.add(basket2, world.basket2.x, world.basket2.y, 0);
+
+  const BulletPool &bullets = world.bullets;
+  for (int i=0;i<bullets.size();i++)
+    batch.add(bullet, lerp(bullets.px[i],bullets.x[i],alpha), lerp(bullets.py[i],bullets.y[i],alpha), -bullets.rot[i]+0.5);
+
+  // Bricks have always been drawn with their translate applied twice,
+  // i.e. at twice their position in the world. Keep it that way.
+  const Sprite *brickSprite[BRICK_COLORS] = { &redBrick, &greenBrick, &blackBrick };
+  for (int c=0;c<BRICK_COLORS;c++)
   {
-    bool aok = chckcollision(bulletx[i], blackx[j], bullety[i], blacky[j], 0.15, 0.4, 0.07,  0.4);
-    if(aok)
-    {
-      ++score;
-      blackx[j] = 100;
-      bulletx[i] = 200;
-    }
+    const BrickPool &p = world.bricks[c];
+    for (int i=0;i<p.size();i++)
+      batch.add(*brickSprite[c], 2*p.x[i], 2*lerp(p.py[i],p.y[i],alpha), 0);
   }
-}
 
-if(bulletStatus == 1)
-{
-  bulletrot[bulletindex] = angleTanGun;
-//cout << "The time now is "<<time_now<<endl;
-bulletStatus = 0;
-if(current_time-bullet_time>=1)
-{
-bullet_time = current_time;
-++bulletindex;
-Matrices.model = glm::mat4(1.0f);
-glm::mat4 translateRectangle1246n = glm::translate (glm::vec3(rect_pos.x+0.2,rect_pos.y+0.3,rect_pos.z));
-glm::mat4 rotateRectangle126n = glm::rotate((float)(-bulletrot[bulletindex]+0.5), glm::vec3(0,0,1)); // rotate about vector (-1,1,1)
-bulletx[bulletindex] = rect_pos.x+0.4;
-bullety[bulletindex] = rect_pos.y+0.2 + 0.75*sin(-angleTanGun+0.5);
-bulletrot[bulletindex] = angleTanGun;
-Matrices.model *= (translateRectangle1246n * rotateRectangle126n);
-MVP = VP * Matrices.model;
-glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-}
-//draw3DObject(bullet[bulletindex]);
-}
-for (int i=0;i<(redBrickIndex);i++)
-{
-  bool tryna = chckcollision(redx[i],b1_pos.x, redy[i], b1_pos.y, 0.7, 0.3, 1, 0.4);
-  if(tryna)
-  {
-    redx[i] = 200;
-    ++score;
-  }
-Matrices.model = glm::mat4(1.0f);
-glm::mat4 translateRectangle = glm::translate (glm::vec3(redx[i],redy[i], 0));        // glTranslatef
-redy[i] = redy[i]-0.01;
-glm::mat4 rotateRectangle = glm::translate(glm::vec3(redx[i],redy[i],0)); // rotate about vector (-1,1,1)
-Matrices.model *= (translateRectangle * rotateRectangle);
-MVP = VP * Matrices.model;
-glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-draw3DObject(redBrick);
-/*if(fabs(((redy[i]-4)-b1_pos.y))<0.5)
-{
-  if(fabs((redx[i]-redrand[i])-b1_pos.x)<0.4)
-  {
-    //++score;
-    //cout<<"Basket is "<<b1_pos.x<<" and "<<b1_pos.y<<endl;
-    //cout<<"Brick is "<<redx[i]-redrand[i]<<" and "<<redy[i]-4<<endl;
-    //cout<<"Score is "<<score<<endl;
-  }
-}*/
-// Increment angle
-
-//camera_rotation_angle++; // Simulating camera rotation
-}
-if(time_now - time_beforered >= 1.5)
-{
-time_beforered = time_now;
-Matrices.model = glm::mat4(1.0f);
-++redBrickIndex;
-redx[redBrickIndex] = randafred;
-redrand[redBrickIndex] = randafred;
-//cout<<"The random variable is: "<<randafred<<endl;
-redy[redBrickIndex] = 4;
-glm::mat4 translateRectangle = glm::translate (glm::vec3(redx[redBrickIndex],redy[redBrickIndex], 0));        // glTranslatef
-glm::mat4 rotateRectangle = glm::translate(glm::vec3(redx[redBrickIndex],redy[redBrickIndex],0)); // rotate about vector (-1,1,1)
-Matrices.model *= (translateRectangle * rotateRectangle);
-MVP = VP * Matrices.model;
-glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-draw3DObject(redBrick);
-}
-
-for (int i=0;i<(greenBrickIndex);i++)
-{
-  bool tryna = chckcollision(greenx[i],b2_pos.x, greeny[i], b2_pos.y,  0.7 , 0.3,1, 0.4);
-  if(tryna)
-  {
-    greenx[i] = 200;
-    ++score;
-  }
-Matrices.model = glm::mat4(1.0f);
-glm::mat4 translateRectangle = glm::translate (glm::vec3(greenx[i],greeny[i], 0));        // glTranslatef
-greeny[i] = greeny[i]-0.01;
-glm::mat4 rotateRectangle = glm::translate(glm::vec3(greenx[i],greeny[i],0)); // rotate about vector (-1,1,1)
-Matrices.model *= (translateRectangle * rotateRectangle);
-MVP = VP * Matrices.model;
-
-glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-
-draw3DObject(greenBrick);
-
-// Increment angle
-
-//camera_rotation_angle++; // Simulating camera rotation
-}
-if(time_now - time_before >= 1.5)
-{
-time_before = time_now;
-Matrices.model = glm::mat4(1.0f);
-++greenBrickIndex;
-greenx[greenBrickIndex] = randaf;
-greenrand[greenBrickIndex] = randaf;
-//cout<<"The random variable is: "<<randafred<<endl;
-greeny[greenBrickIndex] = 4;
-glm::mat4 translateRectangle = glm::translate (glm::vec3(greenx[greenBrickIndex],greeny[greenBrickIndex], 0));        // glTranslatef
-glm::mat4 rotateRectangle = glm::translate(glm::vec3(greenx[greenBrickIndex],greeny[greenBrickIndex],0)); // rotate about vector (-1,1,1)
-Matrices.model *= (translateRectangle * rotateRectangle);
-MVP = VP * Matrices.model;
-glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-draw3DObject(greenBrick);
-}
-
-for (int i=0;i<(blackBrickIndex);i++)
-{
-Matrices.model = glm::mat4(1.0f);
-glm::mat4 translateRectangle = glm::translate (glm::vec3(blackx[i],blacky[i], 0));        // glTranslatef
-blacky[i] = blacky[i]-0.01;
-glm::mat4 rotateRectangle = glm::translate(glm::vec3(blackx[i],blacky[i],0)); // rotate about vector (-1,1,1)
-Matrices.model *= (translateRectangle * rotateRectangle);
-MVP = VP * Matrices.model;
-glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-draw3DObject(blackBrick);
-// Increment angle
-
-//camera_rotation_angle++; // Simulating camera rotation
-}
-if(time_now - time_beforeblack >= 1.5)
-{
-time_beforeblack = time_now;
-//cout << "The time now is "<<time_now<<endl;
-Matrices.model = glm::mat4(1.0f);
-++blackBrickIndex;
-blackx[blackBrickIndex] = randafblack;
-//cout<<"The random variable is: "<<randafblack<<endl;
-blacky[blackBrickIndex] = 4;
-glm::mat4 translateRectangle = glm::translate (glm::vec3(blackx[blackBrickIndex],blacky[blackBrickIndex], 0));        // glTranslatef
-glm::mat4 rotateRectangle = glm::translate(glm::vec3(blackx[blackBrickIndex],blacky[blackBrickIndex],0)); // rotate about vector (-1,1,1)
-Matrices.model *= (translateRectangle * rotateRectangle);
-MVP = VP * Matrices.model;
-glUniformMatrix4fv(Matrices.MatrixID, 1, GL_FALSE, &MVP[0][0]);
-draw3DObject(blackBrick);
-}
+  timer.lap(PROF_DRAW_BUILD);
+  batch.end();
+  gpuTimer.endPass(GPU_SPRITES);
+  timer.lap(PROF_DRAW_SUBMIT);
 }
 
 /* Initialise glfw window, I/O callbacks and the renderer to use */
@@ -1059,10 +543,12 @@ GLFWwindow* initGLFW (int width, int height)
 {
     GLFWwindow* window; // window desciptor/handle
 
+    TraceTimer trace;
     glfwSetErrorCallback(error_callback);
     if (!glfwInit()) {
 //        exit(EXIT_FAILURE);
     }
+    trace.lap("glfwInit");
 
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
@@ -1070,6 +556,7 @@ GLFWwindow* initGLFW (int width, int height)
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
     window = glfwCreateWindow(width, height, "Sample OpenGL 3.3 Application", NULL, NULL);
+    trace.lap("glfwCreateWindow");
 
     if (!window) {
         glfwTerminate();
@@ -1077,7 +564,9 @@ GLFWwindow* initGLFW (int width, int height)
     }
 
     glfwMakeContextCurrent(window);
+    trace.lap("glfwMakeContextCurrent");
     gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+    trace.lap("gladLoadGLLoader");
     glfwSwapInterval( 1 );
 
     /* --- register callbacks with GLFW --- */
@@ -1097,6 +586,7 @@ GLFWwindow* initGLFW (int width, int height)
 
     /* Register function to handle mouse click */
     glfwSetMouseButtonCallback(window, mouseButton);  // mouse button clicks
+    trace.lap("callbacks");
 
     return window;
 }
@@ -1107,23 +597,28 @@ void initGL (GLFWwindow* window, int width, int height)
 {
     /* Objects should be created before any other gl function and shaders */
 	// Create the models
-  createGun();
-  createRectangle ();
-  createBase();
-  createBasket1();
-  createBasket2();
-  creategreenBrick();
-  createredBrick();
-  createblackBrick();
-  createBullet();
-  createMirror();
+  TraceTimer trace;
+  createSprites();
+  trace.lap("createSprites");
+  batch.init(1 << 16);
+  trace.lap("batch.init");
+  gpuTimer.init();
+  trace.lap("gpuTimer.init");
 	// Create and compile our GLSL program from the shaders
+	chrono::steady_clock::time_point shaders_start = chrono::steady_clock::now();
 	programID = LoadShaders( "Sample_GL.vert", "Sample_GL.frag" );
+	cout << "Shaders ready in " << chrono::duration<double, milli>(chrono::steady_clock::now() - shaders_start).count() << " ms" << endl;
 	// Get a handle for our "MVP" uniform
 	Matrices.MatrixID = glGetUniformLocation(programID, "MVP");
+	trace.lap("LoadShaders");
+	const char * shader_dir = getenv("FALLING_BLOCKS_SHADER_DIR");
+	if (shader_dir && shaderWatcher.start(shader_dir, "Sample_GL.vert", "Sample_GL.frag"))
+		cout << "Watching " << shader_dir << " for shader changes" << endl;
+	trace.lap("shaderWatcher.start");
 
 
 	reshapeWindow (window, width, height);
+	trace.lap("reshapeWindow");
 
     // Background color of the scene
 	glClearColor (255, 255, 255, 255); // R, G, B, A
@@ -1137,62 +632,270 @@ void initGL (GLFWwindow* window, int width, int height)
     cout << "RENDERER: " << glGetString(GL_RENDERER) << endl;
     cout << "VERSION: " << glGetString(GL_VERSION) << endl;
     cout << "GLSL: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << endl;
+    cout << "Vertex format: " << sizeof(PackedVertex) << " bytes per vertex (was " << 6*sizeof(GLfloat) << ")" << endl;
+    trace.lap("GL state");
 }
 
-int main (int argc, char** argv)
+/* Apply the replay's input for the coming tick; next is the first
+   event not yet applied */
+void feedReplay (const InputReplay *replay, size_t &next)
 {
-	int width = 1000;
-	int height = 1000;
-  b2_pos = glm::vec3(1.8,-3.3,0);
-  b1_pos = glm::vec3(-2.3,-3.3,0);
-  rect_pos = glm::vec3(-4,-0.2,0);
-  if(indexc==0)
-  {
-  time_before = glfwGetTime();
-  indexc++;
+    while (replay && next < replay->events.size() && replay->events[next].tick == world.tick)
+        applyInput(world, replay->events[next++]);
 }
-if(indexred ==0 )
+
+/* Run the simulation alone, with no window or GL context, and report
+   how fast it ticks. Used to load-test gameplay logic on GPU-less boxes.
+   With a replay its input is fed in at the recorded ticks */
+void runSimTicks (long ticks, const InputReplay *replay = NULL)
 {
-  time_beforered = glfwGetTime();
-  indexred++;
+    const double dt = 1.0/tick_rate;
+    size_t next = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (long t = 0; t < ticks; t++) {
+        feedReplay(replay, next);
+        world.step(dt);
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << ticks << " ticks in " << secs << " s (" << ticks/secs << " ticks/s), score " << world.score << endl;
+    cout << "broadphase: " << world.candidatePairs << " candidate pairs, " << world.hitPairs << " hits, " << overlapBoxesImpl() << " kernel" << endl;
 }
-if(indexblack == 0)
+
+/* Render frames into an offscreen framebuffer with no window, as if the
+   display ran at 60 Hz, and report how fast it went. Frames are written
+   to dumpPrefix00000.ppm and on when dumpPrefix is set */
+int runHeadless (long frames, int width, int height, const char *dumpPrefix, const InputReplay *replay)
 {
-  time_beforeblack = glfwGetTime();
-  indexblack++;
+    TraceTimer trace;
+    HeadlessContext headless;
+    if (!headless.init(width, height)) {
+        headless.destroy();
+        return 1;
+    }
+    trace.lap("HeadlessContext::init");
+    initGL (NULL, width, height);
+    trace.lap("initGL");
+    gameLog.start(stdout);
+    trace.lap("gameLog.start");
+    double first_frame_start = startupTrace.now();
+    world.profilePhases = true;
+
+    const double dt = 1.0/tick_rate;
+    double accumulator = 0;
+    size_t next = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (long f = 0; f < frames; f++) {
+        ProfileScope frame(PROF_FRAME);
+        ProfileTimer timer;
+        reloadShaders();
+        accumulator += 1.0/60;
+        while (accumulator >= dt) {
+            feedReplay(replay, next);
+            world.step(dt);
+            accumulator -= dt;
+        }
+        timer.lap(PROF_SIM);
+
+        TraceTimer trace_frame; // only keeps anything on the first frame
+        draw(accumulator/dt);
+        trace_frame.lap("draw");
+        timer.lap(PROF_DRAW);
+
+        if (dumpPrefix) {
+            char path[1024];
+            snprintf(path, sizeof(path), "%s%05ld.ppm", dumpPrefix, f);
+            if (!headless.writePPM(path))
+                gameLog.printf("Could not write %s\n", path);
+        }
+        // Stands in for the swap: hands the frame to the driver
+        trace_frame.lap("dump frame");
+        glFlush();
+        trace_frame.lap("glFlush");
+        timer.lap(PROF_SWAP);
+        if (!startupTrace.done)
+            finishStartupTrace(first_frame_start);
+    }
+    glFinish();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    gameLog.printf("%ld frames in %g s (%g frames/s), score %g\n", frames, secs, frames/secs, world.score);
+
+    if (profile_on_exit)
+        writeProfile();
+    gameLog.stop();
+    headless.destroy();
+    return 0;
 }
+
+int main (int argc, char** argv)
+{
+    startupTrace.start();
+	int width = 1000;
+	int height = 1000;
+    long sim_ticks = 0;
+    long headless_frames = 0;
+    const char *dump_prefix = NULL;
+    unsigned long long seed = time(NULL);
+    const char *record_path = NULL;
+    InputReplay replay;
+    bool replaying = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--tick-rate") && i+1 < argc) {
+            // dt is 1/tick_rate: anything else never steps or never stops stepping
+            tick_rate = atof(argv[++i]);
+            if (!(tick_rate > 0) || !isfinite(tick_rate)) {
+                cerr << "--tick-rate needs a rate above 0: " << argv[i] << endl;
+                return 1;
+            }
+        }
+        else if (!strcmp(argv[i], "--batch-stats"))
+            show_batch_stats = true;
+        else if (!strcmp(argv[i], "--profile") && i+1 < argc) {
+            profile_path = argv[++i];
+            profile_on_exit = true;
+        }
+        else if (!strcmp(argv[i], "--score-rate") && i+1 < argc)
+            score_rate = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i+1 < argc)
+            seed = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--sim-ticks") && i+1 < argc)
+            sim_ticks = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--spawn-interval") && i+1 < argc)
+            world.config.spawnInterval = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--spawn-burst") && i+1 < argc)
+            world.config.spawnBurst = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--fall-speed") && i+1 < argc)
+            world.config.fallSpeed = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--bullet-speed") && i+1 < argc)
+            world.config.bulletSpeed = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--fire-interval") && i+1 < argc)
+            world.config.fireInterval = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--stress") && i+1 < argc) {
+            world.config.liveBricks = atoi(argv[++i]);
+            if (world.config.liveBricks < 0) {
+                cerr << "--stress needs a brick count of 0 or more: " << argv[i] << endl;
+                return 1;
+            }
+        }
+        else if (!strcmp(argv[i], "--headless") && i+1 < argc)
+            headless_frames = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--dump-frames") && i+1 < argc)
+            dump_prefix = argv[++i];
+        else if (!strcmp(argv[i], "--startup-trace") && i+1 < argc)
+            startup_trace_path = argv[++i];
+        else if (!strcmp(argv[i], "--record") && i+1 < argc)
+            record_path = argv[++i];
+        else if (!strcmp(argv[i], "--replay") && i+1 < argc) {
+            if (!replay.load(argv[++i])) {
+                cerr << "Not a valid input recording: " << argv[i] << endl;
+                return 1;
+            }
+            replaying = true;
+        }
+    }
+
+    // A replay brings its own seed, tick rate and config, or it would diverge
+    if (replaying) {
+        seed = replay.seed;
+        tick_rate = replay.tickRate;
+        world.config = replay.config;
+        sim_ticks = replay.endTick;
+    }
+
+    // Printed so any run can be repeated brick for brick with --seed
+    cout << "Seed: " << seed << endl;
+    world.seed(seed);
+    if (headless_frames > 0)
+        return runHeadless(headless_frames, width, height, dump_prefix, replaying ? &replay : NULL);
+    if (replaying || sim_ticks > 0) {
+        runSimTicks(sim_ticks, replaying ? &replay : NULL);
+        return 0;
+    }
+    if (record_path && !recorder.open(record_path, seed, tick_rate, world.config))
+        cerr << "Could not record input to " << record_path << endl;
+    world.profilePhases = true;
+
+    TraceTimer trace;
     GLFWwindow* window = initGLFW(width, height); // makes the window
+    trace.lap("initGLFW");
 
 	initGL (window, width, height); // intializes the window
-
-    double last_update_time = glfwGetTime();
-srand(time(NULL));
+    trace.lap("initGL");
+
+    const double dt = 1.0/tick_rate;
+    current_time = glfwGetTime();
+    double last_frame_time = current_time;
+    double accumulator = 0;
+    double last_stats_time = current_time;
+    double last_score_time = -1;
+    float printed_score = -1;
+    gameLog.start(stdout);
+    trace.lap("gameLog.start");
+    double first_frame_start = startupTrace.now();
     /* Draw in loop */
     while (!glfwWindowShouldClose(window)) { // as long as window is open?
 
-        // OpenGL Draw commands
+        ProfileScope frame(PROF_FRAME);
+        ProfileTimer timer;
+        reloadShaders();
         glfwGetCursorPos	(window,&xpos,&ypos);
-        angleTan = atan(ypos/xpos);
-        randaf = (rand()%7)-1;
-        randafred = (rand()%7)-1;
-        randafblack = (rand()%7)-1;
-        draw();
+        if (atan(ypos/xpos) != world.aim)
+            input(INPUT_AIM, atan(ypos/xpos));
+        timer.lap(PROF_INPUT);
+
+        // Run the simulation at a fixed rate whatever the display does.
+        // Clamp long frames so a hitch doesn't queue up a burst of steps.
+        current_time = glfwGetTime(); // Time in seconds
+        accumulator += min(current_time - last_frame_time, 0.25);
+        last_frame_time = current_time;
+        while (accumulator >= dt) {
+            world.step(dt);
+            for (int r = 0; r < world.reflected; r++)
+                gameLog.printf("Reflect\n");
+            accumulator -= dt;
+        }
+        timer.lap(PROF_SIM);
+
+        // OpenGL Draw commands
+        TraceTimer trace_frame; // only keeps anything on the first frame
+        draw(accumulator/dt);
+        trace_frame.lap("draw");
+        timer.lap(PROF_DRAW);
+
+        // Only when it changed, and at most score_rate times a second
+        if (world.score != printed_score && (score_rate <= 0 || current_time - last_score_time >= 1/score_rate)) {
+            printed_score = world.score;
+            last_score_time = current_time;
+            gameLog.printf("The score is %g\n", world.score);
+        }
+        if (show_batch_stats && current_time - last_stats_time >= 1) {
+            last_stats_time = current_time;
+            gameLog.printf("batch: %d draw calls, %d vertices, %d flushes, %lld KB uploaded and %d fence waits (%.2f ms) so far (%s)\n",
+                           batch.stats.drawCalls, batch.stats.vertices, batch.stats.flushes,
+                           batch.ring.stats.bytesUploaded/1024, batch.ring.stats.fenceWaits,
+                           batch.ring.stats.waitSeconds*1000,
+                           batch.ring.Persistent ? "persistent" : "glBufferSubData");
+            gameLog.printf("GL state: %d calls issued, %d skipped\n", glState.stats.issued, glState.stats.skipped);
+        }
+        timer.lap(PROF_LOG);
 
         // Swap Frame Buffer in double buffering
+        trace_frame.lap("log");
         glfwSwapBuffers(window); // Swaps the front and back buffers of the specified window.
+        trace_frame.lap("glfwSwapBuffers");
+        timer.lap(PROF_SWAP);
+        if (!startupTrace.done)
+            finishStartupTrace(first_frame_start);
 
         // Poll for Keyboard and mouse events
         glfwPollEvents();
-
-        // Control based on time (Time based transformation like 5 degrees rotation every 0.5s)
-        current_time = glfwGetTime(); // Time in seconds
-        time_now = current_time;
-        if ((current_time - last_update_time) >= 0.5) { // atleast 0.5s elapsed since last frame
-            // do something every 0.5 seconds ..
-            last_update_time = current_time; // every 0.5 seconds, time is updated
-        }
+        timer.lap(PROF_POLL);
     }
 
+    if (profile_on_exit)
+        writeProfile();
+    recorder.close(world.tick);
+    gameLog.stop();
     glfwTerminate();
 //    exit(EXIT_SUCCESS);
 }
@@ -0,0 +1,76 @@
+#include <cmath>
+#include "batch.h"
+#include "glstate.h"
+
+const PackedVertex unitQuad[6] = {
+  {0,0, 255,255,255,255}, {1,0, 255,255,255,255}, {1,1, 255,255,255,255},
+  {1,1, 255,255,255,255}, {0,1, 255,255,255,255}, {0,0, 255,255,255,255},
+};
+
+const PackedVertex unitTriangle[3] = {
+  {0,0, 255,255,255,255}, {1,0, 255,255,255,255}, {1,1, 255,255,255,255},
+};
+
+void SpriteBatch::init(int cap)
+{
+  capacity = cap;
+  fillMode = GL_FILL;
+  vertices.reserve(capacity);
+
+  glGenVertexArrays(1, &VertexArrayID);
+  glState.bindVertexArray(VertexArrayID);
+  // Room for two full flushes per frame before the ring moves on early
+  ring.init(GL_ARRAY_BUFFER, 2*capacity*sizeof(PackedVertex));
+  glState.bindBuffer(GL_ARRAY_BUFFER, ring.Buffer);
+  setPackedVertexAttribs();
+}
+
+void SpriteBatch::begin()
+{
+  vertices.clear();
+  stats.drawCalls = stats.vertices = stats.flushes = 0;
+}
+
+void SpriteBatch::add(const Sprite &sprite, float x, float y, float angle)
+{
+  if (sprite.fillMode != fillMode || (int)vertices.size() + sprite.numVertices > capacity)
+  {
+    flush();
+    fillMode = sprite.fillMode;
+  }
+
+  float c = cos(angle), s = sin(angle);
+  for (int i=0;i<sprite.numVertices;i++)
+  {
+    float lx = (sprite.mesh[i].x - sprite.pivotx)*sprite.w;
+    float ly = (sprite.mesh[i].y - sprite.pivoty)*sprite.h;
+    PackedVertex v;
+    v.x = c*lx - s*ly + x;
+    v.y = s*lx + c*ly + y;
+    v.r = sprite.r; v.g = sprite.g; v.b = sprite.b; v.a = 255;
+    vertices.push_back(v);
+  }
+}
+
+void SpriteBatch::flush()
+{
+  stats.flushes++;
+  if (vertices.empty())
+    return;
+
+  // Offsets in the ring are whole vertices, so draw from there
+  GLintptr at = ring.upload(vertices.data(), vertices.size()*sizeof(PackedVertex), sizeof(PackedVertex));
+  glState.bindVertexArray(VertexArrayID);
+  glState.polygonMode(fillMode);
+  glDrawArrays(GL_TRIANGLES, at/sizeof(PackedVertex), vertices.size());
+
+  stats.drawCalls++;
+  stats.vertices += vertices.size();
+  vertices.clear();
+}
+
+void SpriteBatch::end()
+{
+  flush();
+  ring.endFrame();
+}
@@ -0,0 +1,52 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <vector>
+#include "glloader.h"
+#include "ringbuffer.h"
+#include "vertex.h"
+
+/* A mesh in unit space, (0,0) to (1,1), drawn at a size and colour.
+   (x, y) and rotation in SpriteBatch::add() refer to the pivot, given as
+   a fraction of the size: (0,0) is the bottom-left corner */
+struct Sprite {
+  const PackedVertex *mesh;
+  int numVertices;
+  GLenum fillMode;
+  float w, h;
+  float pivotx, pivoty;
+  GLubyte r, g, b;
+};
+
+/* Shared meshes every sprite is made from */
+extern const PackedVertex unitQuad[6];
+extern const PackedVertex unitTriangle[3]; // bottom-right half of unitQuad
+
+/* What the batch did over one frame */
+struct BatchStats {
+  int drawCalls;
+  int vertices;
+  int flushes;
+};
+
+/* Collects the triangles of every object in a frame into one streaming
+   vertex buffer and draws them together. Objects are placed on the CPU
+   (scale, rotate, then translate), so they all share one MVP. The batch is
+   flushed when the fill mode changes, when it is full, and at end().
+   Vertices go to the GPU through a ring buffer */
+struct SpriteBatch {
+  GLuint VertexArrayID;
+  RingBuffer ring;
+  std::vector<PackedVertex> vertices;
+  int capacity;     // vertices per flush
+  GLenum fillMode;
+  BatchStats stats; // since begin()
+
+  void init(int capacity);
+  void begin();
+  void add(const Sprite &sprite, float x, float y, float angle);
+  void flush();
+  void end();
+};
+
+#endif
@@ -0,0 +1,141 @@
+/* Headless macro-benchmark: runs scripted scenarios through World::step
+   and prints one JSON object with ticks/s, ns per entity per tick and
+   peak memory for each. Built and run by `make bench`.
+
+   Each scenario runs in its own forked process, so its peak RSS isn't
+   inflated by whatever ran before it. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "world.h"
+#include "collide.h"
+#include "rng.h"
+
+using namespace std;
+
+#define TICK_RATE 60.0
+
+struct Scenario {
+  const char *name;
+  int bricks;         // WorldConfig::liveBricks, as --stress sets it
+  int bulletsPerTick; // fired regardless of the turret's cooldown
+  bool atMirror;      // aim the bullets through the mirror
+};
+
+static const Scenario scenarios[] = {
+  { "idle",         0,      0,  false },
+  { "bricks_1k",    1000,   0,  false },
+  { "bricks_100k",  100000, 0,  false },
+  { "heavy_fire",   1000,   10, false },
+  { "mirror",       1000,   10, true  },
+};
+
+static float uniform(Pcg32 &rng, float lo, float hi)
+{
+  return lo + (hi - lo)*(rng.next()*(1.0f/4294967296.0f));
+}
+
+static void fire(World &w, const Scenario &s, Pcg32 &rng)
+{
+  for (int i=0;i<s.bulletsPerTick;i++)
+  {
+    if(s.atMirror)
+      w.bullets.spawn(w.mirror.x - 1, uniform(rng, w.mirror.y - 0.2f, w.mirror.y + 0.2f), uniform(rng, 0.45f, 0.52f)); // close to level
+    else
+      w.bullets.spawn(w.turret.x + 0.4f, uniform(rng, -3, 3), uniform(rng, -1, 1));
+  }
+}
+
+/* Peak resident set size in KB */
+static long peakRSS()
+{
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+  return ru.ru_maxrss/1024;
+#else
+  return ru.ru_maxrss;
+#endif
+}
+
+/* Run one scenario and print its row, after a separator unless it's the
+   first, in one go so a crash can't leave half of it behind */
+static void run(const Scenario &s, long ticks, uint64_t seed, bool firstRow)
+{
+  // The world tops up its own bricks, through the same path as --stress
+  World *w = new World;
+  w->config.liveBricks = s.bricks;
+  w->seed(seed);
+  Pcg32 rng;
+  rng.seed(seed, 100);
+
+  const double dt = 1.0/TICK_RATE;
+  long long entityTicks = 0;
+  double stepSeconds = 0;
+  for (long t=0;t<ticks;t++)
+  {
+    fire(*w, s, rng);
+    int entities = w->bullets.size();
+    for (int c=0;c<BRICK_COLORS;c++)
+      entities += w->bricks[c].size();
+    entityTicks += entities;
+
+    // Only the step is timed, not the scripting around it
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    w->step(dt);
+    stepSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  }
+
+  printf("%s    {\"name\": \"%s\", \"ticks\": %ld, \"seconds\": %.6f, \"ticks_per_sec\": %.1f, "
+         "\"avg_entities\": %.1f, \"ns_per_entity_tick\": %.3f, \"peak_rss_kb\": %ld}",
+         firstRow ? "" : ",\n", s.name, ticks, stepSeconds, ticks/stepSeconds, (double)entityTicks/ticks,
+         entityTicks ? stepSeconds*1e9/entityTicks : 0.0, peakRSS());
+  fflush(stdout);
+  delete w;
+}
+
+int main(int argc, char **argv)
+{
+  long ticks = 2000;
+  uint64_t seed = 1;
+  const char *only = NULL;
+  for (int i=1;i<argc;i++)
+  {
+    if(!strcmp(argv[i], "--ticks") && i+1 < argc)
+      ticks = atol(argv[++i]);
+    else if(!strcmp(argv[i], "--seed") && i+1 < argc)
+      seed = strtoull(argv[++i], NULL, 0);
+    else
+      only = argv[i];
+  }
+
+  printf("{\n  \"tick_rate\": %g, \"seed\": %llu, \"kernel\": \"%s\",\n  \"scenarios\": [\n",
+         TICK_RATE, (unsigned long long)seed, overlapBoxesImpl());
+  bool firstRow = true;
+  for (size_t i=0;i<sizeof(scenarios)/sizeof(scenarios[0]);i++)
+  {
+    if(only && strcmp(only, scenarios[i].name))
+      continue;
+    fflush(stdout);
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+      run(scenarios[i], ticks, seed, firstRow);
+      _exit(0);
+    }
+    int status;
+    if(pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status))
+    {
+      fprintf(stderr, "bench: scenario %s failed\n", scenarios[i].name);
+      return 1;
+    }
+    firstRow = false;
+  }
+  printf("\n  ]\n}\n");
+  return 0;
+}
@@ -0,0 +1,106 @@
+#include <cmath>
+#include <stdlib.h>
+#include <string.h>
+#include "collide.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_SIMD 1
+#endif
+
+typedef int (*OverlapFn)(float, float, float, float, const float *, const float *, int, uint64_t *);
+
+static int countBits(const uint64_t *mask, int n)
+{
+  int hits = 0;
+  for (int w=0;w<(n+63)/64;w++)
+    hits += __builtin_popcountll(mask[w]);
+  return hits;
+}
+
+/* Scalar tail shared by all versions */
+static void overlapRange(float x, float y, float hw, float hh, const float *xs, const float *ys, int from, int n, uint64_t *mask)
+{
+  for (int i=from;i<n;i++)
+    if (fabsf(x - xs[i]) < hw && fabsf(y - ys[i]) < hh)
+      mask[i>>6] |= (uint64_t)1 << (i&63);
+}
+
+static int overlapScalar(float x, float y, float hw, float hh, const float *xs, const float *ys, int n, uint64_t *mask)
+{
+  memset(mask, 0, ((n+63)/64)*sizeof(uint64_t));
+  overlapRange(x, y, hw, hh, xs, ys, 0, n, mask);
+  return countBits(mask, n);
+}
+
+#ifdef HAVE_X86_SIMD
+static int overlapSse2(float x, float y, float hw, float hh, const float *xs, const float *ys, int n, uint64_t *mask)
+{
+  memset(mask, 0, ((n+63)/64)*sizeof(uint64_t));
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 vx = _mm_set1_ps(x), vy = _mm_set1_ps(y);
+  const __m128 vhw = _mm_set1_ps(hw), vhh = _mm_set1_ps(hh);
+  int i = 0;
+  for (;i+4<=n;i+=4)
+  {
+    __m128 dx = _mm_andnot_ps(sign, _mm_sub_ps(vx, _mm_loadu_ps(xs+i)));
+    __m128 dy = _mm_andnot_ps(sign, _mm_sub_ps(vy, _mm_loadu_ps(ys+i)));
+    __m128 hit = _mm_and_ps(_mm_cmplt_ps(dx, vhw), _mm_cmplt_ps(dy, vhh));
+    mask[i>>6] |= (uint64_t)_mm_movemask_ps(hit) << (i&63);
+  }
+  overlapRange(x, y, hw, hh, xs, ys, i, n, mask);
+  return countBits(mask, n);
+}
+
+__attribute__((target("avx2")))
+static int overlapAvx2(float x, float y, float hw, float hh, const float *xs, const float *ys, int n, uint64_t *mask)
+{
+  memset(mask, 0, ((n+63)/64)*sizeof(uint64_t));
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 vx = _mm256_set1_ps(x), vy = _mm256_set1_ps(y);
+  const __m256 vhw = _mm256_set1_ps(hw), vhh = _mm256_set1_ps(hh);
+  int i = 0;
+  for (;i+8<=n;i+=8)
+  {
+    __m256 dx = _mm256_andnot_ps(sign, _mm256_sub_ps(vx, _mm256_loadu_ps(xs+i)));
+    __m256 dy = _mm256_andnot_ps(sign, _mm256_sub_ps(vy, _mm256_loadu_ps(ys+i)));
+    __m256 hit = _mm256_and_ps(_mm256_cmp_ps(dx, vhw, _CMP_LT_OQ), _mm256_cmp_ps(dy, vhh, _CMP_LT_OQ));
+    mask[i>>6] |= (uint64_t)_mm256_movemask_ps(hit) << (i&63);
+  }
+  overlapRange(x, y, hw, hh, xs, ys, i, n, mask);
+  return countBits(mask, n);
+}
+#endif
+
+static const char *implName = "scalar";
+
+static OverlapFn pickOverlap()
+{
+  const char *force = getenv("FALLING_BLOCKS_SIMD");
+  if (force && !strcmp(force, "scalar"))
+    return overlapScalar;
+#ifdef HAVE_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && !(force && !strcmp(force, "sse2")))
+  {
+    implName = "avx2";
+    return overlapAvx2;
+  }
+  implName = "sse2";
+  return overlapSse2;
+#else
+  return overlapScalar;
+#endif
+}
+
+static OverlapFn overlapFn = pickOverlap();
+
+int overlapBoxes(float x, float y, float hw, float hh, const float *xs, const float *ys, int n, uint64_t *mask)
+{
+  return overlapFn(x, y, hw, hh, xs, ys, n, mask);
+}
+
+const char *overlapBoxesImpl()
+{
+  return implName;
+}
@@ -0,0 +1,20 @@
+#ifndef COLLIDE_H
+#define COLLIDE_H
+
+#include <stdint.h>
+
+/* Test one box against n boxes whose centres are in xs/ys. Two boxes
+   overlap when |x - xs[i]| < hw and |y - ys[i]| < hh, where hw and hh
+   are the half sizes of both boxes added together, i.e. (aw + bw)/2.
+   Bit i%64 of mask[i/64] is set for each hit and the number of hits is
+   returned. mask must hold (n+63)/64 words.
+
+   AVX2 and SSE versions are chosen at startup from what the CPU supports,
+   with a scalar fallback elsewhere. FALLING_BLOCKS_SIMD=scalar|sse2|avx2
+   forces one, for comparing them */
+int overlapBoxes(float x, float y, float hw, float hh, const float *xs, const float *ys, int n, uint64_t *mask);
+
+/* Name of the version overlapBoxes uses */
+const char *overlapBoxesImpl();
+
+#endif
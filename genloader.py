@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""Generate a GL loader with only what the game uses.
+
+usage: genloader.py GLCOREARB_H OUT_BASENAME SOURCE...
+
+Scans the sources for gl* functions, GL_* constants and GLAD_GL_* flags,
+looks them up in the Khronos <GL/glcorearb.h>, and writes OUT_BASENAME.h
+and OUT_BASENAME.c. The header is self-contained, so the build doesn't
+need glcorearb.h, only this step does. The API matches the parts of glad
+the game calls (gladLoadGLLoader, glad_gl* pointers behind gl* macros,
+GLAD_GL_* flags), so no call site changes.
+
+The .c resolves every function in gladLoadGLLoader, or, when compiled
+with -DGLLOADER_LAZY, on its first call instead.
+"""
+
+import os
+import re
+import sys
+
+# GL base types, with stdint types standing in for khrplatform's
+BASE_TYPES = """\
+typedef void GLvoid;
+typedef unsigned int GLenum;
+typedef float GLfloat;
+typedef int GLint;
+typedef int GLsizei;
+typedef unsigned int GLbitfield;
+typedef double GLdouble;
+typedef unsigned int GLuint;
+typedef unsigned char GLboolean;
+typedef uint8_t GLubyte;
+typedef float GLclampf;
+typedef double GLclampd;
+typedef ptrdiff_t GLsizeiptr;
+typedef intptr_t GLintptr;
+typedef char GLchar;
+typedef int16_t GLshort;
+typedef int8_t GLbyte;
+typedef uint16_t GLushort;
+typedef uint16_t GLhalf;
+typedef struct __GLsync *GLsync;
+typedef uint64_t GLuint64;
+typedef int64_t GLint64;
+typedef void (APIENTRY *GLDEBUGPROC)(GLenum source,GLenum type,GLuint id,GLenum severity,GLsizei length,const GLchar *message,const void *userParam);
+typedef uint64_t GLuint64EXT;
+typedef int64_t GLint64EXT;
+typedef void (APIENTRY *GLDEBUGPROCARB)(GLenum source,GLenum type,GLuint id,GLenum severity,GLsizei length,const GLchar *message,const void *userParam);
+typedef void *GLeglImageOES;
+typedef void (APIENTRY *GLVULKANPROCNV)(void);
+"""
+
+# Needed by the loader itself to read the version and extensions
+LOADER_FUNCTIONS = ["glGetString", "glGetIntegerv", "glGetStringi"]
+LOADER_CONSTANTS = ["GL_VERSION", "GL_NUM_EXTENSIONS", "GL_EXTENSIONS"]
+
+
+def parse_header(path):
+    text = open(path).read()
+    constants = dict(re.findall(r"^#define (GL_\w+)\s+(\S+)", text, re.M))
+    prototypes = {}
+    for ret, name, params in re.findall(r"^GLAPI (.*?)APIENTRY (gl\w+) \((.*)\);", text, re.M):
+        prototypes[name] = (ret.strip(), params.strip())
+    return constants, prototypes
+
+
+def scan_sources(paths):
+    words = set()
+    for path in paths:
+        words.update(re.findall(r"\b(?:gl[A-Z]\w*|GL_\w+|GLAD_GL_\w+)\b", open(path).read()))
+    return words
+
+
+def param_names(params):
+    """Argument list for forwarding a call: the last identifier of each
+    parameter, e.g. 'const GLchar *const*string' -> 'string'"""
+    if params in ("void", ""):
+        return ""
+    return ", ".join(re.findall(r"(\w+)\s*(?:\[\d*\])?$", p.strip())[0] for p in params.split(","))
+
+
+def main():
+    if len(sys.argv) < 4:
+        sys.exit(__doc__)
+    constants, prototypes = parse_header(sys.argv[1])
+    base = sys.argv[2]
+    words = scan_sources(sys.argv[3:])
+
+    functions = sorted((w for w in words if w in prototypes), key=str.lower)
+    functions += [f for f in LOADER_FUNCTIONS if f not in functions]
+    tokens = sorted(w for w in words if w in constants)
+    tokens += [t for t in LOADER_CONSTANTS if t not in tokens]
+    flags = sorted(w for w in words if w.startswith("GLAD_GL_"))
+    versions = [(f, int(m.group(1)), int(m.group(2))) for f in flags
+                for m in [re.match(r"GLAD_GL_VERSION_(\d+)_(\d+)$", f)] if m]
+    extensions = [f for f in flags if not f.startswith("GLAD_GL_VERSION_")]
+
+    guard = os.path.basename(base).upper().replace(".", "_") + "_H"
+    h = []
+    h.append("/* Generated by genloader.py from glcorearb.h; do not edit */")
+    h.append("#ifndef %s\n#define %s\n" % (guard, guard))
+    h.append("/* Keep other GL headers (e.g. the one GLFW pulls in) out */")
+    for g in ("__gl_h_", "__gl3_h_", "__glext_h_", "__gl_glcorearb_h_", "__glcorearb_h_"):
+        h.append("#define %s" % g)
+    h.append("")
+    h.append("#include <stddef.h>\n#include <stdint.h>\n")
+    h.append("#if defined(_WIN32) && !defined(APIENTRY)\n#define APIENTRY __stdcall\n#endif")
+    h.append("#ifndef APIENTRY\n#define APIENTRY\n#endif")
+    h.append("#ifndef APIENTRYP\n#define APIENTRYP APIENTRY *\n#endif\n")
+    h.append("#ifdef __cplusplus\nextern \"C\" {\n#endif\n")
+    h.append(BASE_TYPES)
+    for t in tokens:
+        h.append("#define %s %s" % (t, constants[t]))
+    h.append("")
+    h.append("typedef void* (*GLADloadproc)(const char *name);")
+    h.append("/* Returns 0 if there's no current context to read a version from */")
+    h.append("int gladLoadGLLoader(GLADloadproc load);\n")
+    for f in flags:
+        h.append("extern int %s;" % f)
+    h.append("")
+    for f in functions:
+        ret, params = prototypes[f]
+        pfn = "PFN%sPROC" % f.upper()
+        h.append("typedef %s (APIENTRYP %s)(%s);" % (ret, pfn, params))
+        h.append("extern %s glad_%s;" % (pfn, f))
+        h.append("#define %s glad_%s" % (f, f))
+    h.append("\n#ifdef __cplusplus\n}\n#endif\n\n#endif")
+
+    c = []
+    c.append("/* Generated by genloader.py from glcorearb.h; do not edit */")
+    c.append("#include <string.h>\n#include \"%s.h\"\n" % os.path.basename(base))
+    c.append("static GLADloadproc loader;\n")
+    for f in flags:
+        c.append("int %s;" % f)
+    c.append("\n#ifdef GLLOADER_LAZY")
+    c.append("/* Each pointer starts at a stub that resolves it and passes the call on */")
+    for f in functions:
+        ret, params = prototypes[f]
+        pfn = "PFN%sPROC" % f.upper()
+        call = "glad_%s(%s)" % (f, param_names(params))
+        c.append("static %s APIENTRY lazy_%s(%s)\n{" % (ret, f, params))
+        c.append("  glad_%s = (%s)loader(\"%s\");" % (f, pfn, f))
+        c.append("  %s%s;\n}" % ("" if ret == "void" else "return ", call))
+        c.append("%s glad_%s = lazy_%s;" % (pfn, f, f))
+    c.append("#else")
+    for f in functions:
+        c.append("PFN%sPROC glad_%s;" % (f.upper(), f))
+    c.append("#endif\n")
+
+    c.append("int gladLoadGLLoader(GLADloadproc load)\n{")
+    c.append("  loader = load;")
+    c.append("  PFNGLGETSTRINGPROC getString = (PFNGLGETSTRINGPROC)load(\"glGetString\");")
+    c.append("  const char *version = getString ? (const char *)getString(GL_VERSION) : NULL;")
+    c.append("  if(!version)\n    return 0;")
+    c.append("  // Skip any prefix such as \"OpenGL ES \"")
+    c.append("  while(*version && (*version < '0' || *version > '9'))\n    version++;")
+    c.append("  int major = 0, minor = 0;")
+    c.append("  for (;*version>='0' && *version<='9';version++)\n    major = major*10 + *version - '0';")
+    c.append("  if(*version == '.')\n    for (version++;*version>='0' && *version<='9';version++)\n      minor = minor*10 + *version - '0';")
+    for f, mj, mn in versions:
+        c.append("  %s = major > %d || (major == %d && minor >= %d);" % (f, mj, mj, mn))
+    if extensions:
+        c.append("")
+        c.append("  // Only the extensions the game asks about are looked for")
+        c.append("  PFNGLGETINTEGERVPROC getIntegerv = (PFNGLGETINTEGERVPROC)load(\"glGetIntegerv\");")
+        c.append("  PFNGLGETSTRINGIPROC getStringi = (PFNGLGETSTRINGIPROC)load(\"glGetStringi\");")
+        c.append("  GLint count = 0;")
+        c.append("  if(getIntegerv && getStringi)\n    getIntegerv(GL_NUM_EXTENSIONS, &count);")
+        c.append("  for (GLint i=0;i<count;i++)\n  {")
+        c.append("    const char *name = (const char *)getStringi(GL_EXTENSIONS, i);")
+        c.append("    if(!name)\n      continue;")
+        for e in extensions:
+            c.append("    if(!strcmp(name, \"%s\"))\n      %s = 1;" % (e[len("GLAD_"):], e))
+        c.append("  }")
+    c.append("\n#ifndef GLLOADER_LAZY")
+    for f in functions:
+        c.append("  glad_%s = (PFN%sPROC)load(\"%s\");" % (f, f.upper(), f))
+    c.append("#endif")
+    c.append("  return 1;\n}")
+
+    open(base + ".h", "w").write("\n".join(h) + "\n")
+    open(base + ".c", "w").write("\n".join(c) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,534 @@
+/* Generated by genloader.py from glcorearb.h; do not edit */
+#include <string.h>
+#include "glloader.h"
+
+static GLADloadproc loader;
+
+int GLAD_GL_ARB_buffer_storage;
+int GLAD_GL_ARB_get_program_binary;
+int GLAD_GL_VERSION_4_1;
+
+#ifdef GLLOADER_LAZY
+/* Each pointer starts at a stub that resolves it and passes the call on */
+static void APIENTRY lazy_glAttachShader(GLuint program, GLuint shader)
+{
+  glad_glAttachShader = (PFNGLATTACHSHADERPROC)loader("glAttachShader");
+  glad_glAttachShader(program, shader);
+}
+PFNGLATTACHSHADERPROC glad_glAttachShader = lazy_glAttachShader;
+static void APIENTRY lazy_glBindBuffer(GLenum target, GLuint buffer)
+{
+  glad_glBindBuffer = (PFNGLBINDBUFFERPROC)loader("glBindBuffer");
+  glad_glBindBuffer(target, buffer);
+}
+PFNGLBINDBUFFERPROC glad_glBindBuffer = lazy_glBindBuffer;
+static void APIENTRY lazy_glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+  glad_glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)loader("glBindFramebuffer");
+  glad_glBindFramebuffer(target, framebuffer);
+}
+PFNGLBINDFRAMEBUFFERPROC glad_glBindFramebuffer = lazy_glBindFramebuffer;
+static void APIENTRY lazy_glBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+  glad_glBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)loader("glBindRenderbuffer");
+  glad_glBindRenderbuffer(target, renderbuffer);
+}
+PFNGLBINDRENDERBUFFERPROC glad_glBindRenderbuffer = lazy_glBindRenderbuffer;
+static void APIENTRY lazy_glBindVertexArray(GLuint array)
+{
+  glad_glBindVertexArray = (PFNGLBINDVERTEXARRAYPROC)loader("glBindVertexArray");
+  glad_glBindVertexArray(array);
+}
+PFNGLBINDVERTEXARRAYPROC glad_glBindVertexArray = lazy_glBindVertexArray;
+static void APIENTRY lazy_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+  glad_glBufferData = (PFNGLBUFFERDATAPROC)loader("glBufferData");
+  glad_glBufferData(target, size, data, usage);
+}
+PFNGLBUFFERDATAPROC glad_glBufferData = lazy_glBufferData;
+static void APIENTRY lazy_glBufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)
+{
+  glad_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)loader("glBufferStorage");
+  glad_glBufferStorage(target, size, data, flags);
+}
+PFNGLBUFFERSTORAGEPROC glad_glBufferStorage = lazy_glBufferStorage;
+static void APIENTRY lazy_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+  glad_glBufferSubData = (PFNGLBUFFERSUBDATAPROC)loader("glBufferSubData");
+  glad_glBufferSubData(target, offset, size, data);
+}
+PFNGLBUFFERSUBDATAPROC glad_glBufferSubData = lazy_glBufferSubData;
+static GLenum APIENTRY lazy_glCheckFramebufferStatus(GLenum target)
+{
+  glad_glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)loader("glCheckFramebufferStatus");
+  return glad_glCheckFramebufferStatus(target);
+}
+PFNGLCHECKFRAMEBUFFERSTATUSPROC glad_glCheckFramebufferStatus = lazy_glCheckFramebufferStatus;
+static void APIENTRY lazy_glClear(GLbitfield mask)
+{
+  glad_glClear = (PFNGLCLEARPROC)loader("glClear");
+  glad_glClear(mask);
+}
+PFNGLCLEARPROC glad_glClear = lazy_glClear;
+static void APIENTRY lazy_glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+  glad_glClearColor = (PFNGLCLEARCOLORPROC)loader("glClearColor");
+  glad_glClearColor(red, green, blue, alpha);
+}
+PFNGLCLEARCOLORPROC glad_glClearColor = lazy_glClearColor;
+static void APIENTRY lazy_glClearDepth(GLdouble depth)
+{
+  glad_glClearDepth = (PFNGLCLEARDEPTHPROC)loader("glClearDepth");
+  glad_glClearDepth(depth);
+}
+PFNGLCLEARDEPTHPROC glad_glClearDepth = lazy_glClearDepth;
+static GLenum APIENTRY lazy_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+  glad_glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)loader("glClientWaitSync");
+  return glad_glClientWaitSync(sync, flags, timeout);
+}
+PFNGLCLIENTWAITSYNCPROC glad_glClientWaitSync = lazy_glClientWaitSync;
+static void APIENTRY lazy_glCompileShader(GLuint shader)
+{
+  glad_glCompileShader = (PFNGLCOMPILESHADERPROC)loader("glCompileShader");
+  glad_glCompileShader(shader);
+}
+PFNGLCOMPILESHADERPROC glad_glCompileShader = lazy_glCompileShader;
+static GLuint APIENTRY lazy_glCreateProgram(void)
+{
+  glad_glCreateProgram = (PFNGLCREATEPROGRAMPROC)loader("glCreateProgram");
+  return glad_glCreateProgram();
+}
+PFNGLCREATEPROGRAMPROC glad_glCreateProgram = lazy_glCreateProgram;
+static GLuint APIENTRY lazy_glCreateShader(GLenum type)
+{
+  glad_glCreateShader = (PFNGLCREATESHADERPROC)loader("glCreateShader");
+  return glad_glCreateShader(type);
+}
+PFNGLCREATESHADERPROC glad_glCreateShader = lazy_glCreateShader;
+static void APIENTRY lazy_glDeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+  glad_glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)loader("glDeleteBuffers");
+  glad_glDeleteBuffers(n, buffers);
+}
+PFNGLDELETEBUFFERSPROC glad_glDeleteBuffers = lazy_glDeleteBuffers;
+static void APIENTRY lazy_glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
+{
+  glad_glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)loader("glDeleteFramebuffers");
+  glad_glDeleteFramebuffers(n, framebuffers);
+}
+PFNGLDELETEFRAMEBUFFERSPROC glad_glDeleteFramebuffers = lazy_glDeleteFramebuffers;
+static void APIENTRY lazy_glDeleteProgram(GLuint program)
+{
+  glad_glDeleteProgram = (PFNGLDELETEPROGRAMPROC)loader("glDeleteProgram");
+  glad_glDeleteProgram(program);
+}
+PFNGLDELETEPROGRAMPROC glad_glDeleteProgram = lazy_glDeleteProgram;
+static void APIENTRY lazy_glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
+{
+  glad_glDeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)loader("glDeleteRenderbuffers");
+  glad_glDeleteRenderbuffers(n, renderbuffers);
+}
+PFNGLDELETERENDERBUFFERSPROC glad_glDeleteRenderbuffers = lazy_glDeleteRenderbuffers;
+static void APIENTRY lazy_glDeleteShader(GLuint shader)
+{
+  glad_glDeleteShader = (PFNGLDELETESHADERPROC)loader("glDeleteShader");
+  glad_glDeleteShader(shader);
+}
+PFNGLDELETESHADERPROC glad_glDeleteShader = lazy_glDeleteShader;
+static void APIENTRY lazy_glDeleteSync(GLsync sync)
+{
+  glad_glDeleteSync = (PFNGLDELETESYNCPROC)loader("glDeleteSync");
+  glad_glDeleteSync(sync);
+}
+PFNGLDELETESYNCPROC glad_glDeleteSync = lazy_glDeleteSync;
+static void APIENTRY lazy_glDepthFunc(GLenum func)
+{
+  glad_glDepthFunc = (PFNGLDEPTHFUNCPROC)loader("glDepthFunc");
+  glad_glDepthFunc(func);
+}
+PFNGLDEPTHFUNCPROC glad_glDepthFunc = lazy_glDepthFunc;
+static void APIENTRY lazy_glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+  glad_glDrawArrays = (PFNGLDRAWARRAYSPROC)loader("glDrawArrays");
+  glad_glDrawArrays(mode, first, count);
+}
+PFNGLDRAWARRAYSPROC glad_glDrawArrays = lazy_glDrawArrays;
+static void APIENTRY lazy_glEnable(GLenum cap)
+{
+  glad_glEnable = (PFNGLENABLEPROC)loader("glEnable");
+  glad_glEnable(cap);
+}
+PFNGLENABLEPROC glad_glEnable = lazy_glEnable;
+static void APIENTRY lazy_glEnableVertexAttribArray(GLuint index)
+{
+  glad_glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC)loader("glEnableVertexAttribArray");
+  glad_glEnableVertexAttribArray(index);
+}
+PFNGLENABLEVERTEXATTRIBARRAYPROC glad_glEnableVertexAttribArray = lazy_glEnableVertexAttribArray;
+static GLsync APIENTRY lazy_glFenceSync(GLenum condition, GLbitfield flags)
+{
+  glad_glFenceSync = (PFNGLFENCESYNCPROC)loader("glFenceSync");
+  return glad_glFenceSync(condition, flags);
+}
+PFNGLFENCESYNCPROC glad_glFenceSync = lazy_glFenceSync;
+static void APIENTRY lazy_glFinish(void)
+{
+  glad_glFinish = (PFNGLFINISHPROC)loader("glFinish");
+  glad_glFinish();
+}
+PFNGLFINISHPROC glad_glFinish = lazy_glFinish;
+static void APIENTRY lazy_glFlush(void)
+{
+  glad_glFlush = (PFNGLFLUSHPROC)loader("glFlush");
+  glad_glFlush();
+}
+PFNGLFLUSHPROC glad_glFlush = lazy_glFlush;
+static void APIENTRY lazy_glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+  glad_glFramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)loader("glFramebufferRenderbuffer");
+  glad_glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+}
+PFNGLFRAMEBUFFERRENDERBUFFERPROC glad_glFramebufferRenderbuffer = lazy_glFramebufferRenderbuffer;
+static void APIENTRY lazy_glGenBuffers(GLsizei n, GLuint *buffers)
+{
+  glad_glGenBuffers = (PFNGLGENBUFFERSPROC)loader("glGenBuffers");
+  glad_glGenBuffers(n, buffers);
+}
+PFNGLGENBUFFERSPROC glad_glGenBuffers = lazy_glGenBuffers;
+static void APIENTRY lazy_glGenFramebuffers(GLsizei n, GLuint *framebuffers)
+{
+  glad_glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)loader("glGenFramebuffers");
+  glad_glGenFramebuffers(n, framebuffers);
+}
+PFNGLGENFRAMEBUFFERSPROC glad_glGenFramebuffers = lazy_glGenFramebuffers;
+static void APIENTRY lazy_glGenQueries(GLsizei n, GLuint *ids)
+{
+  glad_glGenQueries = (PFNGLGENQUERIESPROC)loader("glGenQueries");
+  glad_glGenQueries(n, ids);
+}
+PFNGLGENQUERIESPROC glad_glGenQueries = lazy_glGenQueries;
+static void APIENTRY lazy_glGenRenderbuffers(GLsizei n, GLuint *renderbuffers)
+{
+  glad_glGenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)loader("glGenRenderbuffers");
+  glad_glGenRenderbuffers(n, renderbuffers);
+}
+PFNGLGENRENDERBUFFERSPROC glad_glGenRenderbuffers = lazy_glGenRenderbuffers;
+static void APIENTRY lazy_glGenVertexArrays(GLsizei n, GLuint *arrays)
+{
+  glad_glGenVertexArrays = (PFNGLGENVERTEXARRAYSPROC)loader("glGenVertexArrays");
+  glad_glGenVertexArrays(n, arrays);
+}
+PFNGLGENVERTEXARRAYSPROC glad_glGenVertexArrays = lazy_glGenVertexArrays;
+static void APIENTRY lazy_glGetIntegerv(GLenum pname, GLint *data)
+{
+  glad_glGetIntegerv = (PFNGLGETINTEGERVPROC)loader("glGetIntegerv");
+  glad_glGetIntegerv(pname, data);
+}
+PFNGLGETINTEGERVPROC glad_glGetIntegerv = lazy_glGetIntegerv;
+static void APIENTRY lazy_glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary)
+{
+  glad_glGetProgramBinary = (PFNGLGETPROGRAMBINARYPROC)loader("glGetProgramBinary");
+  glad_glGetProgramBinary(program, bufSize, length, binaryFormat, binary);
+}
+PFNGLGETPROGRAMBINARYPROC glad_glGetProgramBinary = lazy_glGetProgramBinary;
+static void APIENTRY lazy_glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+  glad_glGetProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC)loader("glGetProgramInfoLog");
+  glad_glGetProgramInfoLog(program, bufSize, length, infoLog);
+}
+PFNGLGETPROGRAMINFOLOGPROC glad_glGetProgramInfoLog = lazy_glGetProgramInfoLog;
+static void APIENTRY lazy_glGetProgramiv(GLuint program, GLenum pname, GLint *params)
+{
+  glad_glGetProgramiv = (PFNGLGETPROGRAMIVPROC)loader("glGetProgramiv");
+  glad_glGetProgramiv(program, pname, params);
+}
+PFNGLGETPROGRAMIVPROC glad_glGetProgramiv = lazy_glGetProgramiv;
+static void APIENTRY lazy_glGetQueryObjectiv(GLuint id, GLenum pname, GLint *params)
+{
+  glad_glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)loader("glGetQueryObjectiv");
+  glad_glGetQueryObjectiv(id, pname, params);
+}
+PFNGLGETQUERYOBJECTIVPROC glad_glGetQueryObjectiv = lazy_glGetQueryObjectiv;
+static void APIENTRY lazy_glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 *params)
+{
+  glad_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)loader("glGetQueryObjectui64v");
+  glad_glGetQueryObjectui64v(id, pname, params);
+}
+PFNGLGETQUERYOBJECTUI64VPROC glad_glGetQueryObjectui64v = lazy_glGetQueryObjectui64v;
+static void APIENTRY lazy_glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+  glad_glGetShaderInfoLog = (PFNGLGETSHADERINFOLOGPROC)loader("glGetShaderInfoLog");
+  glad_glGetShaderInfoLog(shader, bufSize, length, infoLog);
+}
+PFNGLGETSHADERINFOLOGPROC glad_glGetShaderInfoLog = lazy_glGetShaderInfoLog;
+static void APIENTRY lazy_glGetShaderiv(GLuint shader, GLenum pname, GLint *params)
+{
+  glad_glGetShaderiv = (PFNGLGETSHADERIVPROC)loader("glGetShaderiv");
+  glad_glGetShaderiv(shader, pname, params);
+}
+PFNGLGETSHADERIVPROC glad_glGetShaderiv = lazy_glGetShaderiv;
+static const GLubyte * APIENTRY lazy_glGetString(GLenum name)
+{
+  glad_glGetString = (PFNGLGETSTRINGPROC)loader("glGetString");
+  return glad_glGetString(name);
+}
+PFNGLGETSTRINGPROC glad_glGetString = lazy_glGetString;
+static GLint APIENTRY lazy_glGetUniformLocation(GLuint program, const GLchar *name)
+{
+  glad_glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)loader("glGetUniformLocation");
+  return glad_glGetUniformLocation(program, name);
+}
+PFNGLGETUNIFORMLOCATIONPROC glad_glGetUniformLocation = lazy_glGetUniformLocation;
+static void APIENTRY lazy_glLinkProgram(GLuint program)
+{
+  glad_glLinkProgram = (PFNGLLINKPROGRAMPROC)loader("glLinkProgram");
+  glad_glLinkProgram(program);
+}
+PFNGLLINKPROGRAMPROC glad_glLinkProgram = lazy_glLinkProgram;
+static void * APIENTRY lazy_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+  glad_glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)loader("glMapBufferRange");
+  return glad_glMapBufferRange(target, offset, length, access);
+}
+PFNGLMAPBUFFERRANGEPROC glad_glMapBufferRange = lazy_glMapBufferRange;
+static void APIENTRY lazy_glPixelStorei(GLenum pname, GLint param)
+{
+  glad_glPixelStorei = (PFNGLPIXELSTOREIPROC)loader("glPixelStorei");
+  glad_glPixelStorei(pname, param);
+}
+PFNGLPIXELSTOREIPROC glad_glPixelStorei = lazy_glPixelStorei;
+static void APIENTRY lazy_glPolygonMode(GLenum face, GLenum mode)
+{
+  glad_glPolygonMode = (PFNGLPOLYGONMODEPROC)loader("glPolygonMode");
+  glad_glPolygonMode(face, mode);
+}
+PFNGLPOLYGONMODEPROC glad_glPolygonMode = lazy_glPolygonMode;
+static void APIENTRY lazy_glProgramBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length)
+{
+  glad_glProgramBinary = (PFNGLPROGRAMBINARYPROC)loader("glProgramBinary");
+  glad_glProgramBinary(program, binaryFormat, binary, length);
+}
+PFNGLPROGRAMBINARYPROC glad_glProgramBinary = lazy_glProgramBinary;
+static void APIENTRY lazy_glProgramParameteri(GLuint program, GLenum pname, GLint value)
+{
+  glad_glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC)loader("glProgramParameteri");
+  glad_glProgramParameteri(program, pname, value);
+}
+PFNGLPROGRAMPARAMETERIPROC glad_glProgramParameteri = lazy_glProgramParameteri;
+static void APIENTRY lazy_glQueryCounter(GLuint id, GLenum target)
+{
+  glad_glQueryCounter = (PFNGLQUERYCOUNTERPROC)loader("glQueryCounter");
+  glad_glQueryCounter(id, target);
+}
+PFNGLQUERYCOUNTERPROC glad_glQueryCounter = lazy_glQueryCounter;
+static void APIENTRY lazy_glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels)
+{
+  glad_glReadPixels = (PFNGLREADPIXELSPROC)loader("glReadPixels");
+  glad_glReadPixels(x, y, width, height, format, type, pixels);
+}
+PFNGLREADPIXELSPROC glad_glReadPixels = lazy_glReadPixels;
+static void APIENTRY lazy_glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+  glad_glRenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)loader("glRenderbufferStorage");
+  glad_glRenderbufferStorage(target, internalformat, width, height);
+}
+PFNGLRENDERBUFFERSTORAGEPROC glad_glRenderbufferStorage = lazy_glRenderbufferStorage;
+static void APIENTRY lazy_glShaderSource(GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length)
+{
+  glad_glShaderSource = (PFNGLSHADERSOURCEPROC)loader("glShaderSource");
+  glad_glShaderSource(shader, count, string, length);
+}
+PFNGLSHADERSOURCEPROC glad_glShaderSource = lazy_glShaderSource;
+static void APIENTRY lazy_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+  glad_glUniformMatrix4fv = (PFNGLUNIFORMMATRIX4FVPROC)loader("glUniformMatrix4fv");
+  glad_glUniformMatrix4fv(location, count, transpose, value);
+}
+PFNGLUNIFORMMATRIX4FVPROC glad_glUniformMatrix4fv = lazy_glUniformMatrix4fv;
+static void APIENTRY lazy_glUseProgram(GLuint program)
+{
+  glad_glUseProgram = (PFNGLUSEPROGRAMPROC)loader("glUseProgram");
+  glad_glUseProgram(program);
+}
+PFNGLUSEPROGRAMPROC glad_glUseProgram = lazy_glUseProgram;
+static void APIENTRY lazy_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer)
+{
+  glad_glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)loader("glVertexAttribPointer");
+  glad_glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+}
+PFNGLVERTEXATTRIBPOINTERPROC glad_glVertexAttribPointer = lazy_glVertexAttribPointer;
+static void APIENTRY lazy_glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+  glad_glViewport = (PFNGLVIEWPORTPROC)loader("glViewport");
+  glad_glViewport(x, y, width, height);
+}
+PFNGLVIEWPORTPROC glad_glViewport = lazy_glViewport;
+static const GLubyte * APIENTRY lazy_glGetStringi(GLenum name, GLuint index)
+{
+  glad_glGetStringi = (PFNGLGETSTRINGIPROC)loader("glGetStringi");
+  return glad_glGetStringi(name, index);
+}
+PFNGLGETSTRINGIPROC glad_glGetStringi = lazy_glGetStringi;
+#else
+PFNGLATTACHSHADERPROC glad_glAttachShader;
+PFNGLBINDBUFFERPROC glad_glBindBuffer;
+PFNGLBINDFRAMEBUFFERPROC glad_glBindFramebuffer;
+PFNGLBINDRENDERBUFFERPROC glad_glBindRenderbuffer;
+PFNGLBINDVERTEXARRAYPROC glad_glBindVertexArray;
+PFNGLBUFFERDATAPROC glad_glBufferData;
+PFNGLBUFFERSTORAGEPROC glad_glBufferStorage;
+PFNGLBUFFERSUBDATAPROC glad_glBufferSubData;
+PFNGLCHECKFRAMEBUFFERSTATUSPROC glad_glCheckFramebufferStatus;
+PFNGLCLEARPROC glad_glClear;
+PFNGLCLEARCOLORPROC glad_glClearColor;
+PFNGLCLEARDEPTHPROC glad_glClearDepth;
+PFNGLCLIENTWAITSYNCPROC glad_glClientWaitSync;
+PFNGLCOMPILESHADERPROC glad_glCompileShader;
+PFNGLCREATEPROGRAMPROC glad_glCreateProgram;
+PFNGLCREATESHADERPROC glad_glCreateShader;
+PFNGLDELETEBUFFERSPROC glad_glDeleteBuffers;
+PFNGLDELETEFRAMEBUFFERSPROC glad_glDeleteFramebuffers;
+PFNGLDELETEPROGRAMPROC glad_glDeleteProgram;
+PFNGLDELETERENDERBUFFERSPROC glad_glDeleteRenderbuffers;
+PFNGLDELETESHADERPROC glad_glDeleteShader;
+PFNGLDELETESYNCPROC glad_glDeleteSync;
+PFNGLDEPTHFUNCPROC glad_glDepthFunc;
+PFNGLDRAWARRAYSPROC glad_glDrawArrays;
+PFNGLENABLEPROC glad_glEnable;
+PFNGLENABLEVERTEXATTRIBARRAYPROC glad_glEnableVertexAttribArray;
+PFNGLFENCESYNCPROC glad_glFenceSync;
+PFNGLFINISHPROC glad_glFinish;
+PFNGLFLUSHPROC glad_glFlush;
+PFNGLFRAMEBUFFERRENDERBUFFERPROC glad_glFramebufferRenderbuffer;
+PFNGLGENBUFFERSPROC glad_glGenBuffers;
+PFNGLGENFRAMEBUFFERSPROC glad_glGenFramebuffers;
+PFNGLGENQUERIESPROC glad_glGenQueries;
+PFNGLGENRENDERBUFFERSPROC glad_glGenRenderbuffers;
+PFNGLGENVERTEXARRAYSPROC glad_glGenVertexArrays;
+PFNGLGETINTEGERVPROC glad_glGetIntegerv;
+PFNGLGETPROGRAMBINARYPROC glad_glGetProgramBinary;
+PFNGLGETPROGRAMINFOLOGPROC glad_glGetProgramInfoLog;
+PFNGLGETPROGRAMIVPROC glad_glGetProgramiv;
+PFNGLGETQUERYOBJECTIVPROC glad_glGetQueryObjectiv;
+PFNGLGETQUERYOBJECTUI64VPROC glad_glGetQueryObjectui64v;
+PFNGLGETSHADERINFOLOGPROC glad_glGetShaderInfoLog;
+PFNGLGETSHADERIVPROC glad_glGetShaderiv;
+PFNGLGETSTRINGPROC glad_glGetString;
+PFNGLGETUNIFORMLOCATIONPROC glad_glGetUniformLocation;
+PFNGLLINKPROGRAMPROC glad_glLinkProgram;
+PFNGLMAPBUFFERRANGEPROC glad_glMapBufferRange;
+PFNGLPIXELSTOREIPROC glad_glPixelStorei;
+PFNGLPOLYGONMODEPROC glad_glPolygonMode;
+PFNGLPROGRAMBINARYPROC glad_glProgramBinary;
+PFNGLPROGRAMPARAMETERIPROC glad_glProgramParameteri;
+PFNGLQUERYCOUNTERPROC glad_glQueryCounter;
+PFNGLREADPIXELSPROC glad_glReadPixels;
+PFNGLRENDERBUFFERSTORAGEPROC glad_glRenderbufferStorage;
+PFNGLSHADERSOURCEPROC glad_glShaderSource;
+PFNGLUNIFORMMATRIX4FVPROC glad_glUniformMatrix4fv;
+PFNGLUSEPROGRAMPROC glad_glUseProgram;
+PFNGLVERTEXATTRIBPOINTERPROC glad_glVertexAttribPointer;
+PFNGLVIEWPORTPROC glad_glViewport;
+PFNGLGETSTRINGIPROC glad_glGetStringi;
+#endif
+
+int gladLoadGLLoader(GLADloadproc load)
+{
+  loader = load;
+  PFNGLGETSTRINGPROC getString = (PFNGLGETSTRINGPROC)load("glGetString");
+  const char *version = getString ? (const char *)getString(GL_VERSION) : NULL;
+  if(!version)
+    return 0;
+  // Skip any prefix such as "OpenGL ES "
+  while(*version && (*version < '0' || *version > '9'))
+    version++;
+  int major = 0, minor = 0;
+  for (;*version>='0' && *version<='9';version++)
+    major = major*10 + *version - '0';
+  if(*version == '.')
+    for (version++;*version>='0' && *version<='9';version++)
+      minor = minor*10 + *version - '0';
+  GLAD_GL_VERSION_4_1 = major > 4 || (major == 4 && minor >= 1);
+
+  // Only the extensions the game asks about are looked for
+  PFNGLGETINTEGERVPROC getIntegerv = (PFNGLGETINTEGERVPROC)load("glGetIntegerv");
+  PFNGLGETSTRINGIPROC getStringi = (PFNGLGETSTRINGIPROC)load("glGetStringi");
+  GLint count = 0;
+  if(getIntegerv && getStringi)
+    getIntegerv(GL_NUM_EXTENSIONS, &count);
+  for (GLint i=0;i<count;i++)
+  {
+    const char *name = (const char *)getStringi(GL_EXTENSIONS, i);
+    if(!name)
+      continue;
+    if(!strcmp(name, "GL_ARB_buffer_storage"))
+      GLAD_GL_ARB_buffer_storage = 1;
+    if(!strcmp(name, "GL_ARB_get_program_binary"))
+      GLAD_GL_ARB_get_program_binary = 1;
+  }
+
+#ifndef GLLOADER_LAZY
+  glad_glAttachShader = (PFNGLATTACHSHADERPROC)load("glAttachShader");
+  glad_glBindBuffer = (PFNGLBINDBUFFERPROC)load("glBindBuffer");
+  glad_glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)load("glBindFramebuffer");
+  glad_glBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)load("glBindRenderbuffer");
+  glad_glBindVertexArray = (PFNGLBINDVERTEXARRAYPROC)load("glBindVertexArray");
+  glad_glBufferData = (PFNGLBUFFERDATAPROC)load("glBufferData");
+  glad_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)load("glBufferStorage");
+  glad_glBufferSubData = (PFNGLBUFFERSUBDATAPROC)load("glBufferSubData");
+  glad_glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)load("glCheckFramebufferStatus");
+  glad_glClear = (PFNGLCLEARPROC)load("glClear");
+  glad_glClearColor = (PFNGLCLEARCOLORPROC)load("glClearColor");
+  glad_glClearDepth = (PFNGLCLEARDEPTHPROC)load("glClearDepth");
+  glad_glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)load("glClientWaitSync");
+  glad_glCompileShader = (PFNGLCOMPILESHADERPROC)load("glCompileShader");
+  glad_glCreateProgram = (PFNGLCREATEPROGRAMPROC)load("glCreateProgram");
+  glad_glCreateShader = (PFNGLCREATESHADERPROC)load("glCreateShader");
+  glad_glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)load("glDeleteBuffers");
+  glad_glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)load("glDeleteFramebuffers");
+  glad_glDeleteProgram = (PFNGLDELETEPROGRAMPROC)load("glDeleteProgram");
+  glad_glDeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)load("glDeleteRenderbuffers");
+  glad_glDeleteShader = (PFNGLDELETESHADERPROC)load("glDeleteShader");
+  glad_glDeleteSync = (PFNGLDELETESYNCPROC)load("glDeleteSync");
+  glad_glDepthFunc = (PFNGLDEPTHFUNCPROC)load("glDepthFunc");
+  glad_glDrawArrays = (PFNGLDRAWARRAYSPROC)load("glDrawArrays");
+  glad_glEnable = (PFNGLENABLEPROC)load("glEnable");
+  glad_glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC)load("glEnableVertexAttribArray");
+  glad_glFenceSync = (PFNGLFENCESYNCPROC)load("glFenceSync");
+  glad_glFinish = (PFNGLFINISHPROC)load("glFinish");
+  glad_glFlush = (PFNGLFLUSHPROC)load("glFlush");
+  glad_glFramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)load("glFramebufferRenderbuffer");
+  glad_glGenBuffers = (PFNGLGENBUFFERSPROC)load("glGenBuffers");
+  glad_glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)load("glGenFramebuffers");
+  glad_glGenQueries = (PFNGLGENQUERIESPROC)load("glGenQueries");
+  glad_glGenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)load("glGenRenderbuffers");
+  glad_glGenVertexArrays = (PFNGLGENVERTEXARRAYSPROC)load("glGenVertexArrays");
+  glad_glGetIntegerv = (PFNGLGETINTEGERVPROC)load("glGetIntegerv");
+  glad_glGetProgramBinary = (PFNGLGETPROGRAMBINARYPROC)load("glGetProgramBinary");
+  glad_glGetProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC)load("glGetProgramInfoLog");
+  glad_glGetProgramiv = (PFNGLGETPROGRAMIVPROC)load("glGetProgramiv");
+  glad_glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)load("glGetQueryObjectiv");
+  glad_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)load("glGetQueryObjectui64v");
+  glad_glGetShaderInfoLog = (PFNGLGETSHADERINFOLOGPROC)load("glGetShaderInfoLog");
+  glad_glGetShaderiv = (PFNGLGETSHADERIVPROC)load("glGetShaderiv");
+  glad_glGetString = (PFNGLGETSTRINGPROC)load("glGetString");
+  glad_glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)load("glGetUniformLocation");
+  glad_glLinkProgram = (PFNGLLINKPROGRAMPROC)load("glLinkProgram");
+  glad_glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)load("glMapBufferRange");
+  glad_glPixelStorei = (PFNGLPIXELSTOREIPROC)load("glPixelStorei");
+  glad_glPolygonMode = (PFNGLPOLYGONMODEPROC)load("glPolygonMode");
+  glad_glProgramBinary = (PFNGLPROGRAMBINARYPROC)load("glProgramBinary");
+  glad_glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC)load("glProgramParameteri");
+  glad_glQueryCounter = (PFNGLQUERYCOUNTERPROC)load("glQueryCounter");
+  glad_glReadPixels = (PFNGLREADPIXELSPROC)load("glReadPixels");
+  glad_glRenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)load("glRenderbufferStorage");
+  glad_glShaderSource = (PFNGLSHADERSOURCEPROC)load("glShaderSource");
+  glad_glUniformMatrix4fv = (PFNGLUNIFORMMATRIX4FVPROC)load("glUniformMatrix4fv");
+  glad_glUseProgram = (PFNGLUSEPROGRAMPROC)load("glUseProgram");
+  glad_glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)load("glVertexAttribPointer");
+  glad_glViewport = (PFNGLVIEWPORTPROC)load("glViewport");
+  glad_glGetStringi = (PFNGLGETSTRINGIPROC)load("glGetStringi");
+#endif
+  return 1;
+}
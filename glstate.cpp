@@ -0,0 +1,70 @@
+#include "glstate.h"
+
+GLStateCache glState;
+
+// Not a valid name or enum, so the first call of each kind goes through
+#define UNKNOWN ((GLuint)~0u)
+
+GLStateCache::GLStateCache()
+{
+  invalidate();
+  stats.issued = stats.skipped = 0;
+}
+
+void GLStateCache::invalidate()
+{
+  program = vertexArray = arrayBuffer = UNKNOWN;
+  fillMode = UNKNOWN;
+}
+
+void GLStateCache::useProgram(GLuint id)
+{
+  if (program == id)
+  {
+    stats.skipped++;
+    return;
+  }
+  program = id;
+  stats.issued++;
+  glUseProgram(id);
+}
+
+void GLStateCache::bindVertexArray(GLuint id)
+{
+  if (vertexArray == id)
+  {
+    stats.skipped++;
+    return;
+  }
+  vertexArray = id;
+  stats.issued++;
+  glBindVertexArray(id);
+}
+
+void GLStateCache::bindBuffer(GLenum target, GLuint id)
+{
+  // Only GL_ARRAY_BUFFER is shadowed; it is global state, not part of the VAO
+  if (target == GL_ARRAY_BUFFER)
+  {
+    if (arrayBuffer == id)
+    {
+      stats.skipped++;
+      return;
+    }
+    arrayBuffer = id;
+  }
+  stats.issued++;
+  glBindBuffer(target, id);
+}
+
+void GLStateCache::polygonMode(GLenum mode)
+{
+  if (fillMode == mode)
+  {
+    stats.skipped++;
+    return;
+  }
+  fillMode = mode;
+  stats.issued++;
+  glPolygonMode(GL_FRONT_AND_BACK, mode);
+}
@@ -0,0 +1,33 @@
+#ifndef GLSTATE_H
+#define GLSTATE_H
+
+#include "glloader.h"
+
+struct GLStateStats {
+  int issued;  // calls passed on to GL
+  int skipped; // calls dropped because GL was already in that state
+};
+
+/* Shadow copy of the GL state the game changes, so that calls which
+   would not change anything never reach the driver. Everything that sets
+   these must go through here, or the shadow goes stale; invalidate()
+   forgets it all for when that can't be helped */
+struct GLStateCache {
+  GLuint program;
+  GLuint vertexArray;
+  GLuint arrayBuffer;
+  GLenum fillMode;
+  GLStateStats stats; // reset by the caller, once a frame
+
+  GLStateCache();
+  void invalidate();
+
+  void useProgram(GLuint id);
+  void bindVertexArray(GLuint id);
+  void bindBuffer(GLenum target, GLuint id);
+  void polygonMode(GLenum mode);
+};
+
+extern GLStateCache glState;
+
+#endif
@@ -0,0 +1,49 @@
+#include "gputimer.h"
+
+GpuTimer gpuTimer;
+
+static const ProfilePhase passPhase[GPU_PASSES] = { PROF_GPU_CLEAR, PROF_GPU_SPRITES };
+
+void GpuTimer::init()
+{
+  glGenQueries(GPU_QUERY_FRAMES*(GPU_PASSES + 1), &queries[0][0]);
+  for (int i=0;i<GPU_QUERY_FRAMES;i++)
+    pending[i] = false;
+  frame = dropped = 0;
+}
+
+void GpuTimer::beginFrame()
+{
+  int slot = frame % GPU_QUERY_FRAMES;
+  GLuint *q = queries[slot];
+  if(pending[slot])
+  {
+    // The last timestamp finishes last, so once it's there they all are
+    GLint available = 0;
+    glGetQueryObjectiv(q[GPU_PASSES], GL_QUERY_RESULT_AVAILABLE, &available);
+    if(available)
+    {
+      GLuint64 t[GPU_PASSES + 1];
+      for (int i=0;i<=GPU_PASSES;i++)
+        glGetQueryObjectui64v(q[i], GL_QUERY_RESULT, &t[i]);
+      for (int p=0;p<GPU_PASSES;p++)
+        profiler.add(passPhase[p], (t[p+1] - t[p])/1000.0f);
+      profiler.add(PROF_GPU_FRAME, (t[GPU_PASSES] - t[0])/1000.0f);
+    }
+    else
+      dropped++;
+  }
+  glQueryCounter(q[0], GL_TIMESTAMP);
+  pending[slot] = false;
+}
+
+void GpuTimer::endPass(GpuPass p)
+{
+  int slot = frame % GPU_QUERY_FRAMES;
+  glQueryCounter(queries[slot][p + 1], GL_TIMESTAMP);
+  if(p == GPU_PASSES - 1)
+  {
+    pending[slot] = true;
+    frame++;
+  }
+}
@@ -0,0 +1,31 @@
+#ifndef GPUTIMER_H
+#define GPUTIMER_H
+
+#include "glloader.h"
+#include "profile.h"
+
+#define GPU_QUERY_FRAMES 4 // frames of latency before a result is read back
+
+/* Render passes timed on the GPU, in the order draw() issues them */
+enum GpuPass { GPU_CLEAR, GPU_SPRITES, GPU_PASSES };
+
+/* GPU time per pass, from GL_TIMESTAMP queries at each pass boundary.
+   Each frame writes its own set of queries in a ring and reads back the
+   set written GPU_QUERY_FRAMES frames earlier, so the CPU never waits on
+   a result; if one still isn't ready it is dropped rather than waited
+   for. The times go into the profiler next to the CPU phases */
+struct GpuTimer {
+  GLuint queries[GPU_QUERY_FRAMES][GPU_PASSES + 1]; // [0] is the start of the frame
+  bool pending[GPU_QUERY_FRAMES];
+  int frame;     // frames begun
+  int dropped;   // result sets that weren't ready in time
+
+  void init();
+  void beginFrame();
+  /* Call once the commands for pass p have been issued */
+  void endPass(GpuPass p);
+};
+
+extern GpuTimer gpuTimer;
+
+#endif
@@ -0,0 +1,50 @@
+#include <cmath>
+#include "grid.h"
+
+Grid::Grid(float minx, float miny, float maxx, float maxy, float cellSize)
+  : minx(minx), miny(miny), cellSize(cellSize)
+{
+  cols = (int)ceil((maxx - minx)/cellSize);
+  rows = (int)ceil((maxy - miny)/cellSize);
+  cellStart.resize(cols*rows + 1);
+}
+
+int Grid::cellX(float x) const
+{
+  int c = (int)floor((x - minx)/cellSize);
+  return c < 0 ? 0 : c >= cols ? cols-1 : c;
+}
+
+int Grid::cellY(float y) const
+{
+  int c = (int)floor((y - miny)/cellSize);
+  return c < 0 ? 0 : c >= rows ? rows-1 : c;
+}
+
+void Grid::build(const float *x, const float *y, int n)
+{
+  int ncells = cols*rows;
+  cellStart.assign(ncells + 1, 0);
+  cellOf.resize(n);
+  items.resize(n);
+  sx.resize(n);
+  sy.resize(n);
+
+  for (int i=0;i<n;i++)
+  {
+    cellOf[i] = cellY(y[i])*cols + cellX(x[i]);
+    cellStart[cellOf[i]]++;
+  }
+  // Running sum gives the end of each cell; filling each cell back to
+  // front then leaves cellStart[c] at the cell's first item
+  for (int c=1;c<ncells;c++)
+    cellStart[c] += cellStart[c-1];
+  cellStart[ncells] = n;
+  for (int i=n-1;i>=0;i--)
+  {
+    int k = --cellStart[cellOf[i]];
+    items[k] = i;
+    sx[k] = x[i];
+    sy[k] = y[i];
+  }
+}
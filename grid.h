@@ -0,0 +1,42 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include <vector>
+
+/* Uniform grid over the play field, used as the collision broadphase.
+   Points are bucketed by cell; anything outside the field is clamped
+   into the border cells, so queries stay conservative. The grid is
+   rebuilt from scratch each step with a counting sort, which is cheaper
+   than updating it as entities move and get removed */
+struct Grid {
+  float minx, miny, cellSize;
+  int cols, rows;
+  std::vector<int> cellStart; // items of cell c are items[cellStart[c] .. cellStart[c+1])
+  std::vector<int> items;     // point indices, grouped by cell
+  std::vector<float> sx, sy;  // point positions in the same order as items
+  std::vector<int> cellOf;    // scratch: cell of each point
+
+  Grid(float minx, float miny, float maxx, float maxy, float cellSize);
+
+  int cellX(float x) const;
+  int cellY(float y) const;
+
+  void build(const float *x, const float *y, int n);
+
+  /* Call f(begin, end) for the runs of items in the cells overlapping
+     the box. Neighbouring cells in a row are stored back to back, so
+     that is one run per row, ready to hand to overlapBoxes() */
+  template <class F> void query(float x0, float y0, float x1, float y1, F f) const
+  {
+    int cx0 = cellX(x0), cx1 = cellX(x1);
+    int cy0 = cellY(y0), cy1 = cellY(y1);
+    for (int cy=cy0;cy<=cy1;cy++)
+    {
+      int begin = cellStart[cy*cols + cx0], end = cellStart[cy*cols + cx1 + 1];
+      if (begin < end)
+        f(begin, end);
+    }
+  }
+};
+
+#endif
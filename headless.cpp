@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <vector>
+#include "headless.h"
+#include "trace.h"
+
+#ifdef __linux__
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+bool HeadlessContext::init(int w, int h)
+{
+  width = w;
+  height = h;
+  display = context = NULL;
+  TraceTimer trace;
+
+  PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+    (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+  if(!getPlatformDisplay)
+  {
+    fprintf(stderr, "headless: EGL has no eglGetPlatformDisplayEXT\n");
+    return false;
+  }
+  EGLDisplay dpy = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+  EGLint major, minor;
+  if(dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, &major, &minor))
+  {
+    fprintf(stderr, "headless: no surfaceless EGL display\n");
+    return false;
+  }
+  display = dpy;
+  if(!eglBindAPI(EGL_OPENGL_API))
+  {
+    fprintf(stderr, "headless: EGL has no desktop OpenGL\n");
+    return false;
+  }
+  trace.lap("eglInitialize");
+
+  // Surfaceless contexts need no config (EGL_KHR_no_config_context)
+  const EGLint attribs[] = {
+    EGL_CONTEXT_MAJOR_VERSION, 3,
+    EGL_CONTEXT_MINOR_VERSION, 3,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_NONE
+  };
+  EGLContext ctx = eglCreateContext(dpy, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attribs);
+  if(ctx == EGL_NO_CONTEXT || !eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, ctx))
+  {
+    if(ctx != EGL_NO_CONTEXT)
+      eglDestroyContext(dpy, ctx);
+    fprintf(stderr, "headless: could not create a GL 3.3 core context\n");
+    return false;
+  }
+  context = ctx;
+  trace.lap("eglCreateContext");
+  gladLoadGLLoader((GLADloadproc) eglGetProcAddress);
+  trace.lap("gladLoadGLLoader");
+
+  glGenRenderbuffers(2, Renderbuffers);
+  glBindRenderbuffer(GL_RENDERBUFFER, Renderbuffers[0]);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+  glBindRenderbuffer(GL_RENDERBUFFER, Renderbuffers[1]);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+  glGenFramebuffers(1, &Framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, Framebuffer);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, Renderbuffers[0]);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, Renderbuffers[1]);
+  if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+  {
+    fprintf(stderr, "headless: framebuffer incomplete\n");
+    return false;
+  }
+  trace.lap("framebuffer");
+  return true;
+}
+
+void HeadlessContext::destroy()
+{
+  if(!display)
+    return;
+  if(context)
+  {
+    glDeleteFramebuffers(1, &Framebuffer);
+    glDeleteRenderbuffers(2, Renderbuffers);
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+  }
+  eglTerminate(display);
+  display = context = NULL;
+}
+
+#else
+
+bool HeadlessContext::init(int w, int h)
+{
+  fprintf(stderr, "headless: only supported on Linux (EGL)\n");
+  return false;
+}
+
+void HeadlessContext::destroy()
+{
+}
+
+#endif
+
+bool HeadlessContext::writePPM(const char *path)
+{
+  std::vector<unsigned char> pixels(width*height*3);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+  FILE *f = fopen(path, "wb");
+  if(!f)
+    return false;
+  fprintf(f, "P6\n%d %d\n255\n", width, height);
+  // GL's rows start at the bottom, PPM's at the top
+  for (int y=height-1;y>=0;y--)
+    fwrite(&pixels[y*width*3], 1, width*3, f);
+  fclose(f);
+  return true;
+}
@@ -0,0 +1,29 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include "glloader.h"
+
+/* A GL 3.3 core context with no window, for rendering on machines with
+   no display (CI, render farm nodes). It comes from EGL's surfaceless
+   platform, which Mesa provides with llvmpipe when there's no GPU, and
+   draws into a framebuffer object the size of the window it replaces.
+   Only built on Linux; elsewhere init() just fails */
+struct HeadlessContext {
+  void *display;       // EGLDisplay
+  void *context;       // EGLContext
+  GLuint Framebuffer;
+  GLuint Renderbuffers[2]; // colour, depth
+  int width, height;
+
+  /* Creates the context, makes it current, loads GL and binds the
+     framebuffer. Returns false with a message on stderr on failure,
+     after which destroy() still frees what was set up */
+  bool init(int w, int h);
+  void destroy();
+
+  /* Write the framebuffer to a binary PPM. Reads back synchronously,
+     so it waits for the frame to finish */
+  bool writePPM(const char *path);
+};
+
+#endif
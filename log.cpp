@@ -0,0 +1,85 @@
+#include <stdarg.h>
+#include <chrono>
+#include "log.h"
+
+using namespace std;
+
+AsyncLog gameLog;
+
+AsyncLog::AsyncLog()
+  : head(0), tail(0), running(false), out(NULL), dropped(0)
+{
+}
+
+AsyncLog::~AsyncLog()
+{
+  stop();
+}
+
+void AsyncLog::start(FILE *f)
+{
+  out = f;
+  running = true;
+  writer = thread(&AsyncLog::run, this);
+}
+
+void AsyncLog::stop()
+{
+  if(!running)
+    return;
+  running = false;
+  writer.join();
+  drain();
+  if(dropped)
+    fprintf(stderr, "log: %lld lines dropped\n", dropped);
+}
+
+void AsyncLog::printf(const char *fmt, ...)
+{
+  unsigned h = head.load(memory_order_relaxed);
+  if(h - tail.load(memory_order_acquire) == LOG_SLOTS)
+  {
+    ++dropped;
+    return;
+  }
+  LogLine &l = lines[h % LOG_SLOTS];
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(l.text, LOG_LINE_MAX, fmt, args);
+  va_end(args);
+  if(n >= LOG_LINE_MAX)
+  {
+    // Cut short, but keep the line ending so it doesn't run into the next
+    n = LOG_LINE_MAX;
+    l.text[n - 1] = '\n';
+  }
+  l.len = n < 0 ? 0 : n;
+  head.store(h + 1, memory_order_release);
+}
+
+/* Write out every complete line queued so far */
+void AsyncLog::drain()
+{
+  unsigned t = tail.load(memory_order_relaxed);
+  unsigned h = head.load(memory_order_acquire);
+  if(t == h)
+    return;
+  for (;t!=h;t++)
+  {
+    const LogLine &l = lines[t % LOG_SLOTS];
+    fwrite(l.text, 1, l.len, out);
+    tail.store(t + 1, memory_order_release);
+  }
+  fflush(out);
+}
+
+void AsyncLog::run()
+{
+  // Polling keeps the producer side free of locks and wakeups; a few ms
+  // of latency doesn't matter for a score line
+  while(running)
+  {
+    drain();
+    this_thread::sleep_for(chrono::milliseconds(5));
+  }
+}
@@ -0,0 +1,47 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+
+#define LOG_SLOTS 256    // lines that can be queued before new ones are dropped
+#define LOG_LINE_MAX 160 // longer lines are cut short
+
+struct LogLine {
+  int len;
+  char text[LOG_LINE_MAX];
+};
+
+/* Text output that never blocks the frame loop. printf() formats into a
+   slot of a single-producer/single-consumer ring and returns; a writer
+   thread copies finished lines to the file and does the flushing, so a
+   slow pipe only ever stalls that thread. If the ring is full the line is
+   dropped and counted rather than waited for.
+
+   Only one thread (the game loop) may call printf() */
+struct AsyncLog {
+  LogLine lines[LOG_SLOTS];
+  std::atomic<unsigned> head;   // next slot to fill, written by the producer
+  std::atomic<unsigned> tail;   // next slot to write out, written by the writer
+  std::atomic<bool> running;
+  std::thread writer;
+  FILE *out;
+  long long dropped;
+
+  AsyncLog();
+  ~AsyncLog();
+
+  void start(FILE *f);
+  /* Write out whatever is queued and stop the writer thread */
+  void stop();
+
+  void printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+  void drain();
+  void run();
+};
+
+extern AsyncLog gameLog;
+
+#endif
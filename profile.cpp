@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include "profile.h"
+
+using namespace std;
+
+Profiler profiler;
+
+static const char *phaseNames[PROF_PHASES] = {
+  "frame", "input", "sim", "sim.bullets", "sim.catch", "sim.bricks",
+  "log", "draw", "draw.build", "draw.submit", "swap", "poll",
+  "gpu.frame", "gpu.clear", "gpu.sprites"
+};
+
+Profiler::Profiler()
+{
+  memset(phases, 0, sizeof(phases));
+}
+
+void Profiler::add(ProfilePhase p, float us)
+{
+  PhaseHistory &h = phases[p];
+  h.us[h.samples % PROFILE_WINDOW] = us;
+  h.samples++;
+}
+
+/* Nearest-rank percentile of n sorted values */
+static float percentile(const float *sorted, int n, int pct)
+{
+  int rank = (pct*n + 99)/100;
+  return sorted[max(rank, 1) - 1];
+}
+
+bool Profiler::writeCSV(const char *path) const
+{
+  FILE *f = fopen(path, "w");
+  if(!f)
+    return false;
+  fprintf(f, "phase,samples,mean_us,p50_us,p95_us,p99_us,max_us\n");
+  float sorted[PROFILE_WINDOW];
+  for (int p=0;p<PROF_PHASES;p++)
+  {
+    const PhaseHistory &h = phases[p];
+    int n = (int)min(h.samples, (long long)PROFILE_WINDOW);
+    if(!n)
+    {
+      fprintf(f, "%s,0,,,,,\n", phaseNames[p]);
+      continue;
+    }
+    copy(h.us, h.us + n, sorted);
+    sort(sorted, sorted + n);
+    double sum = 0;
+    for (int i=0;i<n;i++)
+      sum += sorted[i];
+    fprintf(f, "%s,%lld,%.2f,%.2f,%.2f,%.2f,%.2f\n", phaseNames[p], h.samples, sum/n,
+            percentile(sorted, n, 50), percentile(sorted, n, 95), percentile(sorted, n, 99), sorted[n-1]);
+  }
+  fclose(f);
+  return true;
+}
@@ -0,0 +1,74 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <chrono>
+
+/* Phases of a frame that get timed. SIM_* are parts of World::step and
+   are sampled once per tick, so there are several of them per frame at
+   high tick rates */
+enum ProfilePhase {
+  PROF_FRAME,
+  PROF_INPUT,
+  PROF_SIM,
+  PROF_SIM_BULLETS,  // mirror, bullet movement and bullet/brick collision
+  PROF_SIM_CATCH,    // basket collision
+  PROF_SIM_BRICKS,   // brick movement and spawning
+  PROF_LOG,
+  PROF_DRAW,
+  PROF_DRAW_BUILD,   // filling the sprite batch
+  PROF_DRAW_SUBMIT,  // uploading and drawing it
+  PROF_SWAP,
+  PROF_POLL,
+  PROF_GPU_FRAME,    // GPU time, read back a few frames late (see GpuTimer)
+  PROF_GPU_CLEAR,
+  PROF_GPU_SPRITES,
+  PROF_PHASES
+};
+
+#define PROFILE_WINDOW 1024 // samples kept per phase for the percentiles
+
+/* The last PROFILE_WINDOW samples of one phase, in microseconds */
+struct PhaseHistory {
+  float us[PROFILE_WINDOW];
+  long long samples; // since start; the newest is at us[(samples-1) % PROFILE_WINDOW]
+};
+
+/* Rolling timings for every phase. Percentiles are only worked out when
+   written, so recording a sample is a store and an increment */
+struct Profiler {
+  PhaseHistory phases[PROF_PHASES];
+
+  Profiler();
+  void add(ProfilePhase p, float us);
+
+  /* One row per phase: samples, mean, p50, p95, p99 and max over the
+     window. Returns false if the file can't be written */
+  bool writeCSV(const char *path) const;
+};
+
+extern Profiler profiler;
+
+/* Times a run of back-to-back phases: each lap() records the time since
+   the last one (or since construction) as a sample of that phase */
+struct ProfileTimer {
+  std::chrono::steady_clock::time_point start;
+
+  ProfileTimer() : start(std::chrono::steady_clock::now()) {}
+  void lap(ProfilePhase p)
+  {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    profiler.add(p, std::chrono::duration<float, std::micro>(now - start).count());
+    start = now;
+  }
+};
+
+/* Times the rest of the enclosing block as one sample of a phase */
+struct ProfileScope {
+  ProfilePhase phase;
+  ProfileTimer timer;
+
+  ProfileScope(ProfilePhase p) : phase(p) {}
+  ~ProfileScope() { timer.lap(phase); }
+};
+
+#endif
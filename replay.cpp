@@ -0,0 +1,102 @@
+#include <string.h>
+#include <cmath>
+#include "replay.h"
+
+#define REPLAY_VERSION 2
+
+void applyInput(World &w, const InputEvent &e)
+{
+  switch(e.kind)
+  {
+    case INPUT_AIM:     w.aim = e.value; break;
+    case INPUT_FIRE:    w.fire(e.value); break;
+    case INPUT_BASKET1: w.moveBasket1(e.value); break;
+    case INPUT_BASKET2: w.moveBasket2(e.value); break;
+    case INPUT_TURRET:  w.moveTurret(e.value); break;
+    default: break;
+  }
+}
+
+/* Read or write the config a field at a time, like the events */
+template <class IO> static bool configIO(IO io, WorldConfig &c, FILE *f)
+{
+  return io(&c.spawnInterval, sizeof(c.spawnInterval), 1, f) == 1 &&
+         io(&c.spawnBurst, sizeof(c.spawnBurst), 1, f) == 1 &&
+         io(&c.fallSpeed, sizeof(c.fallSpeed), 1, f) == 1 &&
+         io(&c.bulletSpeed, sizeof(c.bulletSpeed), 1, f) == 1 &&
+         io(&c.fireInterval, sizeof(c.fireInterval), 1, f) == 1 &&
+         io(&c.liveBricks, sizeof(c.liveBricks), 1, f) == 1;
+}
+
+static size_t writeField(void *p, size_t size, size_t n, FILE *f)
+{
+  return fwrite(p, size, n, f);
+}
+
+bool InputRecorder::open(const char *path, uint64_t seed, double tickRate, const WorldConfig &config)
+{
+  f = fopen(path, "wb");
+  if(!f)
+    return false;
+  uint32_t version = REPLAY_VERSION;
+  fwrite("FBIN", 1, 4, f);
+  fwrite(&version, sizeof(version), 1, f);
+  fwrite(&seed, sizeof(seed), 1, f);
+  fwrite(&tickRate, sizeof(tickRate), 1, f);
+  WorldConfig c = config;
+  configIO(writeField, c, f);
+  return true;
+}
+
+void InputRecorder::record(const InputEvent &e)
+{
+  if(!f)
+    return;
+  // Field by field, so the struct's padding stays out of the file
+  fwrite(&e.tick, sizeof(e.tick), 1, f);
+  fwrite(&e.kind, sizeof(e.kind), 1, f);
+  fwrite(&e.value, sizeof(e.value), 1, f);
+}
+
+void InputRecorder::close(uint32_t tick)
+{
+  if(!f)
+    return;
+  InputEvent end = { tick, INPUT_END, 0 };
+  record(end);
+  fclose(f);
+  f = NULL;
+}
+
+bool InputReplay::load(const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  if(!f)
+    return false;
+  char magic[4];
+  uint32_t version;
+  if(fread(magic, 1, 4, f) != 4 || memcmp(magic, "FBIN", 4) ||
+     fread(&version, sizeof(version), 1, f) != 1 || version != REPLAY_VERSION ||
+     fread(&seed, sizeof(seed), 1, f) != 1 || fread(&tickRate, sizeof(tickRate), 1, f) != 1 ||
+     !configIO(fread, config, f) ||
+     !(tickRate > 0) || !std::isfinite(tickRate) || // would hang or never step the replay
+     config.liveBricks < 0)
+  {
+    fclose(f);
+    return false;
+  }
+  events.clear();
+  endTick = 0;
+  InputEvent e;
+  while(fread(&e.tick, sizeof(e.tick), 1, f) == 1 &&
+        fread(&e.kind, sizeof(e.kind), 1, f) == 1 &&
+        fread(&e.value, sizeof(e.value), 1, f) == 1)
+  {
+    endTick = e.tick;
+    if(e.kind == INPUT_END)
+      break;
+    events.push_back(e);
+  }
+  fclose(f);
+  return true;
+}
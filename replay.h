@@ -0,0 +1,55 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include "world.h"
+
+/* Player input as the world sees it, so a session can be recorded and
+   fed back into a World with no window. Each event is stamped with the
+   tick it was applied before; with the same seed and tick rate a replay
+   then steps through exactly the same states as the session did */
+
+enum InputKind {
+  INPUT_AIM,      // value: gun angle
+  INPUT_FIRE,     // value: angle to fire at
+  INPUT_BASKET1,  // value: dx
+  INPUT_BASKET2,  // value: dx
+  INPUT_TURRET,   // value: dy
+  INPUT_END       // last event of a recording, at the tick it stopped
+};
+
+struct InputEvent {
+  uint32_t tick;
+  uint8_t kind;
+  double value;
+};
+
+void applyInput(World &w, const InputEvent &e);
+
+/* File layout, all little-endian: the 4 bytes "FBIN", uint32 version,
+   uint64 seed, double tick rate, the WorldConfig fields in declaration
+   order, then 13-byte events (uint32 tick, uint8 kind, double value)
+   ending with INPUT_END */
+struct InputRecorder {
+  FILE *f;
+
+  InputRecorder() : f(NULL) {}
+  bool open(const char *path, uint64_t seed, double tickRate, const WorldConfig &config);
+  void record(const InputEvent &e);
+  void close(uint32_t tick);
+};
+
+struct InputReplay {
+  uint64_t seed;
+  double tickRate;
+  WorldConfig config;
+  uint32_t endTick;
+  std::vector<InputEvent> events; // in tick order
+
+  /* Returns false if the file is missing or not a recording */
+  bool load(const char *path);
+};
+
+#endif
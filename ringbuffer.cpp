@@ -0,0 +1,97 @@
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include "ringbuffer.h"
+#include "glstate.h"
+
+void RingBuffer::init(GLenum target, GLsizeiptr segmentSize)
+{
+  Target = target;
+  SegmentSize = segmentSize;
+  segment = 0;
+  used = 0;
+  for (int i=0;i<FRAMES_IN_FLIGHT;i++)
+    fences[i] = 0;
+  stats.bytesUploaded = 0;
+  stats.fenceWaits = 0;
+  stats.waitSeconds = 0;
+
+  const char *env = getenv("FALLING_BLOCKS_BUFFER_STORAGE");
+  Persistent = GLAD_GL_ARB_buffer_storage && !(env && !strcmp(env, "0"));
+  Mapped = NULL;
+
+  glGenBuffers(1, &Buffer);
+  glState.bindBuffer(Target, Buffer);
+  if (Persistent)
+  {
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(Target, FRAMES_IN_FLIGHT*SegmentSize, NULL, flags);
+    Mapped = (char*)glMapBufferRange(Target, 0, FRAMES_IN_FLIGHT*SegmentSize, flags);
+    if (!Mapped)
+    {
+      // Storage is immutable now, so start over with a fresh buffer
+      glDeleteBuffers(1, &Buffer);
+      glState.invalidate();
+      glGenBuffers(1, &Buffer);
+      glState.bindBuffer(Target, Buffer);
+      Persistent = false;
+    }
+  }
+  if (!Persistent)
+    glBufferData(Target, FRAMES_IN_FLIGHT*SegmentSize, NULL, GL_STREAM_DRAW);
+}
+
+void RingBuffer::nextSegment()
+{
+  if (fences[segment])
+    glDeleteSync(fences[segment]);
+  fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  segment = (segment + 1) % FRAMES_IN_FLIGHT;
+  used = 0;
+
+  GLsync fence = fences[segment];
+  if (!fence)
+    return;
+  // Poll first; only count it as a wait if the GPU isn't done yet
+  GLenum r = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+  if (r == GL_TIMEOUT_EXPIRED)
+  {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    stats.fenceWaits++;
+    do
+      r = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+    while (r == GL_TIMEOUT_EXPIRED);
+    stats.waitSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+  glDeleteSync(fence);
+  fences[segment] = 0;
+}
+
+GLintptr RingBuffer::upload(const void *data, GLsizeiptr size, GLsizeiptr align)
+{
+  GLsizeiptr offset = (used + align - 1)/align*align;
+  if (offset + size > SegmentSize)
+  {
+    nextSegment();
+    offset = 0;
+  }
+  GLintptr at = segment*SegmentSize + offset;
+
+  if (Persistent)
+    memcpy(Mapped + at, data, size);
+  else
+  {
+    glState.bindBuffer(Target, Buffer);
+    glBufferSubData(Target, at, size, data);
+  }
+
+  used = offset + size;
+  stats.bytesUploaded += size;
+  return at;
+}
+
+void RingBuffer::endFrame()
+{
+  nextSegment();
+}
@@ -0,0 +1,49 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include "glloader.h"
+
+#define FRAMES_IN_FLIGHT 3
+
+/* Running totals for a ring buffer */
+struct RingStats {
+  long long bytesUploaded;
+  int fenceWaits;     // times the CPU had to wait for the GPU to free a segment
+  double waitSeconds; // time spent in those waits
+};
+
+/* Streaming memory for per-frame GPU data. One buffer is split into
+   FRAMES_IN_FLIGHT segments, used in turn; each segment is fenced once the
+   GPU has been given its draws, and the fence is waited on before the
+   segment is written again, so nothing is reallocated or stalled on
+   implicitly by the driver.
+
+   With ARB_buffer_storage the buffer is mapped once, persistently, and
+   written directly. Plain GL 3.3 uses glBufferSubData into the segment.
+   FALLING_BLOCKS_BUFFER_STORAGE=0 forces the GL 3.3 path */
+struct RingBuffer {
+  GLuint Buffer;
+  GLenum Target;
+  GLsizeiptr SegmentSize;
+  bool Persistent;
+  char *Mapped;              // whole buffer, when Persistent
+
+  int segment;               // segment being written
+  GLsizeiptr used;           // bytes used in it
+  GLsync fences[FRAMES_IN_FLIGHT];
+  RingStats stats;
+
+  void init(GLenum target, GLsizeiptr segmentSize);
+
+  /* Copy size bytes in, aligned to align, and return their offset in
+     Buffer. Moves on to the next segment if this one is full, so size
+     must not exceed SegmentSize */
+  GLintptr upload(const void *data, GLsizeiptr size, GLsizeiptr align);
+
+  /* Call after the last draw that reads this frame's data */
+  void endFrame();
+
+  void nextSegment();
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/* PCG32 (XSH-RR) from pcg-random.org: 64 bits of state, a few cycles a
+   number and, unlike rand(), the same sequence on every platform for a
+   given seed. Streams with different seq never overlap */
+struct Pcg32 {
+  uint64_t state, inc;
+
+  void seed(uint64_t initstate, uint64_t seq)
+  {
+    state = 0;
+    inc = (seq << 1) | 1;
+    next();
+    state += initstate;
+    next();
+  }
+
+  uint32_t next()
+  {
+    uint64_t old = state;
+    state = old*6364136223846793005ULL + inc;
+    uint32_t xorshifted = ((old >> 18) ^ old) >> 27;
+    uint32_t rot = old >> 59;
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+  }
+
+  /* Uniform in [0, n), by multiply-and-shift rather than modulo */
+  uint32_t below(uint32_t n)
+  {
+    return (uint32_t)(((uint64_t)next()*n) >> 32);
+  }
+};
+
+#endif
@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "shadercache.h"
+
+using namespace std;
+
+#define CACHE_MAGIC "FBSC"
+
+/* 64-bit FNV-1a; fine for telling versions of a file apart */
+static uint64_t fnv1a(uint64_t h, const void *data, size_t n)
+{
+  const unsigned char *p = (const unsigned char *)data;
+  for (size_t i=0;i<n;i++)
+    h = (h ^ p[i])*1099511628211ULL;
+  return h;
+}
+
+static uint64_t hashString(uint64_t h, const char *s)
+{
+  // Include the terminator so "ab"+"c" and "a"+"bc" differ
+  return s ? fnv1a(h, s, strlen(s) + 1) : fnv1a(h, "", 1);
+}
+
+void ShaderCache::init()
+{
+  const char *env = getenv("FALLING_BLOCKS_SHADER_CACHE");
+  path = env ? env : "shader.cache";
+  GLint formats = 0;
+  if(GLAD_GL_VERSION_4_1 || GLAD_GL_ARB_get_program_binary)
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+  enabled = formats > 0 && !path.empty();
+}
+
+uint64_t ShaderCache::key(const string &vertexSource, const string &fragmentSource)
+{
+  uint64_t h = 14695981039346656037ULL;
+  h = hashString(h, vertexSource.c_str());
+  h = hashString(h, fragmentSource.c_str());
+  h = hashString(h, (const char *)glGetString(GL_VENDOR));
+  h = hashString(h, (const char *)glGetString(GL_RENDERER));
+  h = hashString(h, (const char *)glGetString(GL_VERSION));
+  return h;
+}
+
+/* File layout: "FBSC", uint64 key, uint32 binary format, uint32 length,
+   then the binary */
+GLuint ShaderCache::load(uint64_t key)
+{
+  if(!enabled)
+    return 0;
+  FILE *f = fopen(path.c_str(), "rb");
+  if(!f)
+    return 0;
+  char magic[4];
+  uint64_t fileKey;
+  uint32_t format, length;
+  vector<char> binary;
+  bool ok = fread(magic, 1, 4, f) == 4 && !memcmp(magic, CACHE_MAGIC, 4) &&
+            fread(&fileKey, sizeof(fileKey), 1, f) == 1 && fileKey == key &&
+            fread(&format, sizeof(format), 1, f) == 1 &&
+            fread(&length, sizeof(length), 1, f) == 1 && length > 0;
+  if(ok)
+  {
+    binary.resize(length);
+    ok = fread(binary.data(), 1, length, f) == length;
+  }
+  fclose(f);
+  if(!ok)
+    return 0;
+
+  GLuint program = glCreateProgram();
+  glProgramBinary(program, format, binary.data(), length);
+  GLint linked = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &linked);
+  if(!linked)
+  {
+    glDeleteProgram(program);
+    return 0;
+  }
+  return program;
+}
+
+void ShaderCache::prepare(GLuint program)
+{
+  if(enabled)
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void ShaderCache::save(GLuint program, uint64_t key)
+{
+  if(!enabled)
+    return;
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if(length <= 0)
+    return;
+  vector<char> binary(length);
+  GLenum format;
+  glGetProgramBinary(program, length, &length, &format, binary.data());
+
+  FILE *f = fopen(path.c_str(), "wb");
+  if(!f)
+    return;
+  uint32_t format32 = format, length32 = length;
+  fwrite(CACHE_MAGIC, 1, 4, f);
+  fwrite(&key, sizeof(key), 1, f);
+  fwrite(&format32, sizeof(format32), 1, f);
+  fwrite(&length32, sizeof(length32), 1, f);
+  fwrite(binary.data(), 1, length, f);
+  fclose(f);
+}
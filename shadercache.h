@@ -0,0 +1,34 @@
+#ifndef SHADERCACHE_H
+#define SHADERCACHE_H
+
+#include <stdint.h>
+#include <string>
+#include "glloader.h"
+
+/* Linked programs saved to disk with glGetProgramBinary, so later runs
+   can skip compiling and linking. An entry is keyed by a hash of the
+   shader sources and the GL vendor, renderer and version strings; a
+   driver update or shader edit changes the key and the entry is simply
+   rebuilt. The driver may also reject a binary it wrote itself, which is
+   treated the same as a miss.
+
+   Needs GL 4.1 or ARB_get_program_binary and a driver that offers at
+   least one binary format. FALLING_BLOCKS_SHADER_CACHE sets the cache
+   file (default "shader.cache"); setting it empty turns caching off */
+struct ShaderCache {
+  bool enabled;
+  std::string path;
+
+  void init();
+
+  uint64_t key(const std::string &vertexSource, const std::string &fragmentSource);
+
+  /* A linked program for key, or 0 if there isn't a usable one */
+  GLuint load(uint64_t key);
+
+  /* Call before linking a program that will be saved */
+  void prepare(GLuint program);
+  void save(GLuint program, uint64_t key);
+};
+
+#endif
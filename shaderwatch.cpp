@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <iterator>
+#include "shaderwatch.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static string readWhole(const string &path)
+{
+  ifstream stream(path.c_str(), ios::in | ios::binary);
+  return string(istreambuf_iterator<char>(stream), istreambuf_iterator<char>());
+}
+
+ShaderWatcher::ShaderWatcher()
+  : fd(-1), running(false), changed(false)
+{
+}
+
+ShaderWatcher::~ShaderWatcher()
+{
+  stop();
+}
+
+bool ShaderWatcher::poll(string &vertex, string &fragment)
+{
+  lock_guard<mutex> guard(lock);
+  if(!changed)
+    return false;
+  changed = false;
+  vertex.swap(vertexSource);
+  fragment.swap(fragmentSource);
+  return true;
+}
+
+#ifdef __linux__
+
+bool ShaderWatcher::start(const char *directory, const char *vertex, const char *fragment)
+{
+  dir = directory;
+  vertexName = vertex;
+  fragmentName = fragment;
+  fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if(fd < 0)
+    return false;
+  // Editors either write in place or write a new file and rename it over
+  if(inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+  {
+    close(fd);
+    fd = -1;
+    return false;
+  }
+  running = true;
+  watcher = thread(&ShaderWatcher::run, this);
+  return true;
+}
+
+void ShaderWatcher::stop()
+{
+  if(!running)
+    return;
+  running = false;
+  watcher.join();
+  close(fd);
+  fd = -1;
+}
+
+void ShaderWatcher::run()
+{
+  char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+  while(running)
+  {
+    // Wake up now and then to see if we should stop
+    struct pollfd p = { fd, POLLIN, 0 };
+    if(::poll(&p, 1, 100) <= 0)
+      continue;
+
+    bool ours = false;
+    ssize_t len;
+    while((len = read(fd, buf, sizeof(buf))) > 0)
+      for (char *at=buf;at<buf+len;)
+      {
+        const struct inotify_event *e = (const struct inotify_event *)at;
+        if(e->len && (vertexName == e->name || fragmentName == e->name))
+          ours = true;
+        at += sizeof(struct inotify_event) + e->len;
+      }
+    if(!ours)
+      continue;
+
+    // A save can come as several events; let it settle, then read once
+    usleep(50000);
+    while(read(fd, buf, sizeof(buf)) > 0)
+      ;
+    string vertex = readWhole(dir + "/" + vertexName);
+    string fragment = readWhole(dir + "/" + fragmentName);
+    lock_guard<mutex> guard(lock);
+    vertexSource.swap(vertex);
+    fragmentSource.swap(fragment);
+    changed = true;
+  }
+}
+
+#else
+
+bool ShaderWatcher::start(const char *directory, const char *vertex, const char *fragment)
+{
+  return false;
+}
+
+void ShaderWatcher::stop()
+{
+}
+
+void ShaderWatcher::run()
+{
+}
+
+#endif
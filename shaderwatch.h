@@ -0,0 +1,38 @@
+#ifndef SHADERWATCH_H
+#define SHADERWATCH_H
+
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+/* Watches the directory shaders are loaded from (FALLING_BLOCKS_SHADER_DIR)
+   with inotify on a thread of its own. When either shader is saved, the
+   thread rereads both, so the frame loop never touches the disk; the
+   frame loop picks the new sources up with poll() at the start of a frame
+   and does the compile itself, as that needs the GL context.
+
+   Linux only; elsewhere start() just returns false */
+struct ShaderWatcher {
+  std::string dir, vertexName, fragmentName;
+  int fd;                      // inotify instance
+  std::atomic<bool> running;
+  std::thread watcher;
+
+  std::mutex lock;             // guards the three below
+  bool changed;
+  std::string vertexSource, fragmentSource;
+
+  ShaderWatcher();
+  ~ShaderWatcher();
+
+  bool start(const char *directory, const char *vertex, const char *fragment);
+  void stop();
+
+  /* True, with the new sources, if the shaders changed since last asked */
+  bool poll(std::string &vertex, std::string &fragment);
+
+  void run();
+};
+
+#endif
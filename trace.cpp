@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "trace.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+StartupTrace startupTrace;
+
+/* How long the process ran before now: its start time in /proc, in clock
+   ticks since boot, against the boot-time clock */
+static double processAgeUs()
+{
+#ifdef __linux__
+  FILE *f = fopen("/proc/self/stat", "r");
+  if(!f)
+    return 0;
+  char buf[1024];
+  size_t len = fread(buf, 1, sizeof(buf) - 1, f);
+  fclose(f);
+  buf[len] = 0;
+
+  // The command name may hold spaces or ')', so count fields from the last ')'.
+  // The start time is field 22; this is field 3
+  const char *fields = strrchr(buf, ')');
+  unsigned long long startTicks;
+  if(!fields || sscanf(fields + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu",
+                       &startTicks) != 1)
+    return 0;
+  struct timespec now;
+  if(clock_gettime(CLOCK_BOOTTIME, &now))
+    return 0;
+  double us = (now.tv_sec + now.tv_nsec*1e-9 - (double)startTicks/sysconf(_SC_CLK_TCK))*1e6;
+  return us > 0 ? us : 0;
+#else
+  return 0;
+#endif
+}
+
+void StartupTrace::start()
+{
+  mainStart = chrono::steady_clock::now();
+  preMainUs = processAgeUs();
+  count = 0;
+  done = false;
+  if(preMainUs > 0)
+  {
+    TraceEvent &e = events[count++];
+    e.name = "exec to main";
+    e.startUs = 0;
+    e.durUs = preMainUs;
+  }
+}
+
+void StartupTrace::add(const char *name, double startUs)
+{
+  if(done || count == TRACE_MAX_EVENTS)
+    return;
+  TraceEvent &e = events[count++];
+  e.name = name;
+  e.startUs = startUs;
+  e.durUs = now() - startUs;
+}
+
+void StartupTrace::finish()
+{
+  add("main to first frame", preMainUs);
+  done = true;
+}
+
+bool StartupTrace::writeJSON(const char *path) const
+{
+  FILE *f = fopen(path, "w");
+  if(!f)
+    return false;
+  fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"startup\"}}");
+  for (int i=0;i<count;i++)
+    fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.1f,\"dur\":%.1f}",
+            events[i].name, events[i].startUs, events[i].durUs);
+  fprintf(f, "\n]}\n");
+  return fclose(f) == 0;
+}
@@ -0,0 +1,67 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+
+#define TRACE_MAX_EVENTS 64 // spans kept; startup has a few dozen
+
+/* One timed span. Spans that fall inside another are shown nested in it */
+struct TraceEvent {
+  const char *name;  // a string literal
+  double startUs;    // since the process started
+  double durUs;
+};
+
+/* A timeline of startup, from the process starting to the first frame
+   on screen, written as Chrome trace JSON for chrome://tracing or
+   ui.perfetto.dev. Spans go into a fixed array until finish(), so a
+   traced phase costs two clock reads; after finish() nothing more is
+   kept and tracing is a branch.
+
+   On Linux the time before main(), mostly the dynamic linker loading GL
+   and GLFW, comes from the start time in /proc, which is only to the
+   clock tick (10 ms) */
+struct StartupTrace {
+  std::chrono::steady_clock::time_point mainStart;
+  double preMainUs;
+  TraceEvent events[TRACE_MAX_EVENTS];
+  int count;
+  bool done;
+
+  /* Call first thing in main() */
+  void start();
+
+  /* Microseconds since the process started, or 0 once finished */
+  double now() const
+  {
+    if(done)
+      return 0;
+    return preMainUs + std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - mainStart).count();
+  }
+
+  /* A span from startUs (a now() value) to now */
+  void add(const char *name, double startUs);
+
+  /* The first frame is out: close the main() span and stop tracing */
+  void finish();
+
+  /* Returns false if the file can't be written */
+  bool writeJSON(const char *path) const;
+};
+
+extern StartupTrace startupTrace;
+
+/* Traces a run of back-to-back phases: each lap() records a span from
+   the last one (or from construction) to now */
+struct TraceTimer {
+  double start;
+
+  TraceTimer() : start(startupTrace.now()) {}
+  void lap(const char *name)
+  {
+    startupTrace.add(name, start);
+    start = startupTrace.now();
+  }
+};
+
+#endif
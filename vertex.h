@@ -0,0 +1,30 @@
+#ifndef VERTEX_H
+#define VERTEX_H
+
+#include "glloader.h"
+
+/* Vertex layout shared by the static objects and the sprite batch: a 2D
+   position (z was always 0) and an 8-bit RGBA colour, interleaved.
+   That is 12 bytes a vertex, against 24 for separate xyz and rgb floats */
+struct PackedVertex {
+  GLfloat x, y;
+  GLubyte r, g, b, a;
+};
+
+inline GLubyte packColor(GLfloat c)
+{
+  return (GLubyte)(c*255 + 0.5f);
+}
+
+/* Point attributes 0 (position) and 1 (colour) of the bound VAO at
+   PackedVertex data in the bound GL_ARRAY_BUFFER. The shader still sees
+   vec3s: z comes out as 0 and the colour as 0..1 */
+inline void setPackedVertexAttribs()
+{
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)0);
+  glEnableVertexAttribArray(1);
+  glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PackedVertex), (void*)(2*sizeof(GLfloat)));
+}
+
+#endif
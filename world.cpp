@@ -0,0 +1,255 @@
+#include <cmath>
+#include <stdlib.h>
+#include <algorithm>
+#include "world.h"
+#include "collide.h"
+#include "profile.h"
+
+using namespace std;
+
+/* All speeds below were tuned as "per frame" with vsync on a 60 Hz
+   display, so scale them by how many of those frames dt covers */
+#define REFERENCE_HZ 60.0
+
+/* Move the last element of v into slot i and drop the last slot */
+template <class T> static void swapPop(std::vector<T> &v, int i)
+{
+  v[i] = v.back();
+  v.pop_back();
+}
+
+void BrickPool::spawn(float x0, float y0)
+{
+  x.push_back(x0); y.push_back(y0); py.push_back(y0);
+}
+
+void BrickPool::remove(int i)
+{
+  swapPop(x, i); swapPop(y, i); swapPop(py, i);
+}
+
+void BulletPool::spawn(float x0, float y0, double angle)
+{
+  x.push_back(x0); y.push_back(y0); px.push_back(x0); py.push_back(y0); rot.push_back(angle);
+}
+
+void BulletPool::remove(int i)
+{
+  swapPop(x, i); swapPop(y, i); swapPop(px, i); swapPop(py, i); swapPop(rot, i);
+}
+
+WorldConfig::WorldConfig()
+  : spawnInterval(1.5), spawnBurst(1), fallSpeed(0.01), bulletSpeed(0.1),
+    fireInterval(1), liveBricks(0)
+{
+}
+
+World::World()
+  : blackGrid(-4, -4, 4, 4, 0.5)
+{
+  basket1.x = -2.3; basket1.y = -3.3;
+  basket2.x = 1.8;  basket2.y = -3.3;
+  turret.x = -4;    turret.y = -0.2;
+  mirror.x = 2.5;   mirror.y = 0;
+
+  aim = fireAim = 0;
+  fireRequested = false;
+  score = 0;
+  time = 0;
+  tick = 0;
+  for(int c=0;c<BRICK_COLORS;c++)
+    lastSpawn[c] = 0;
+  seed(0);
+  bullet_time = 0;
+  reflected = 0;
+  candidatePairs = hitPairs = 0;
+  profilePhases = false;
+}
+
+void World::seed(uint64_t s)
+{
+  for(int c=0;c<BRICK_COLORS;c++)
+    spawnRng[c].seed(s, c);
+}
+
+void World::fire(double angle)
+{
+  fireAim = angle;
+  fireRequested = true;
+}
+
+void World::moveBasket1(float dx)
+{
+  if((dx < 0 && basket1.x > -2.8) || (dx > 0 && basket1.x < 2.8))
+    basket1.x += dx;
+}
+
+void World::moveBasket2(float dx)
+{
+  if((dx < 0 && basket2.x > -2.8) || (dx > 0 && basket2.x < 1.8))
+    basket2.x += dx;
+}
+
+void World::moveTurret(float dy)
+{
+  if((dy < 0 && turret.y > -1) || (dy > 0 && turret.y < 2.2))
+    turret.y += dy;
+}
+
+/* ProfileTimer for the phases of a step, doing nothing when it's off */
+struct StepTimer {
+  bool on;
+  chrono::steady_clock::time_point start;
+
+  StepTimer(bool enabled) : on(enabled)
+  {
+    if(on)
+      start = chrono::steady_clock::now();
+  }
+  void lap(ProfilePhase p)
+  {
+    if(!on)
+      return;
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    profiler.add(p, chrono::duration<float, micro>(now - start).count());
+    start = now;
+  }
+};
+
+/* Index of the highest set bit */
+static int topBit(uint64_t m)
+{
+  return 63 - __builtin_clzll(m);
+}
+
+/* Catch bricks of one colour in a basket */
+static void catchBricks(BrickPool &p, const Vec2 &basket, float &score, std::vector<uint64_t> &mask)
+{
+  int n = p.size();
+  mask.resize((n+63)/64);
+  if(!overlapBoxes(basket.x, basket.y, (0.7f + 0.3f)/2, (1.0f + 0.4f)/2, p.x.data(), p.y.data(), n, mask.data()))
+    return;
+  // Top down, so swap-and-pop only ever moves bricks already looked at
+  for (int w=(n+63)/64-1;w>=0;w--)
+    for (uint64_t m=mask[w];m;m&=~((uint64_t)1 << topBit(m)))
+    {
+      p.remove(w*64 + topBit(m));
+      ++score;
+    }
+}
+
+void World::step(double dt)
+{
+  float k = dt * REFERENCE_HZ;
+  time += dt;
+  tick++;
+  StepTimer timer(profilePhases);
+
+  for(int c=0;c<BRICK_COLORS;c++)
+    bricks[c].py = bricks[c].y;
+  bullets.px = bullets.x;
+  bullets.py = bullets.y;
+
+  int n = bullets.size();
+  hitMask.resize((n+63)/64);
+  reflected = 0;
+  if(overlapBoxes(mirror.x, mirror.y, (0.4f + 0.15f)/2, (0.4f + 0.07f)/2, bullets.x.data(), bullets.y.data(), n, hitMask.data()))
+  {
+    for (int j=0;j<n;j++)
+      if(hitMask[j>>6] >> (j&63) & 1)
+      {
+        bullets.rot[j] = bullets.rot[j]*(M_PI);
+        reflected++;
+      }
+  }
+
+  // Bullets against black bricks. Only bricks in grid cells near a bullet
+  // are tested; shot bricks are removed afterwards so the grid's indices
+  // stay valid through the loop
+  BrickPool &black = bricks[BRICK_BLACK];
+  blackGrid.build(black.x.data(), black.y.data(), black.size());
+  shot.assign(black.size(), 0);
+  hitMask.resize(max(hitMask.size(), (size_t)(black.size()+63)/64));
+  const float hw = (0.15f + 0.4f)/2, hh = (0.07f + 0.4f)/2;
+  float bk = k*(config.bulletSpeed/0.1);
+  for (int i=0;i<bullets.size();)
+  {
+    bullets.x[i] = bullets.x[i] + 0.1*bk;
+    bullets.y[i] = bullets.y[i] + ((cos(-bullets.rot[i] - 1.085))/4)*bk;
+    float bx = bullets.x[i], by = bullets.y[i];
+    bool spent = bx>4 || fabs(by)>4;
+    if(!spent)
+    {
+      blackGrid.query(bx - hw, by - hh, bx + hw, by + hh, [&](int begin, int end) {
+        if(spent)
+          return;
+        candidatePairs += end - begin;
+        if(!overlapBoxes(bx, by, hw, hh, &blackGrid.sx[begin], &blackGrid.sy[begin], end - begin, hitMask.data()))
+          return;
+        for (int b=0;b<end-begin && !spent;b++)
+        {
+          int j = blackGrid.items[begin + b];
+          if(!(hitMask[b>>6] >> (b&63) & 1) || shot[j])
+            continue;
+          ++hitPairs;
+          ++score;
+          shot[j] = 1;
+          spent = true;
+        }
+      });
+    }
+    if(spent)
+      bullets.remove(i);
+    else
+      i++;
+  }
+  for (int j=black.size()-1;j>=0;j--)
+    if(shot[j])
+      black.remove(j);
+
+  if(fireRequested)
+  {
+    fireRequested = false;
+    if(time-bullet_time>=config.fireInterval)
+    {
+      bullet_time = time;
+      bullets.spawn(turret.x+0.4, turret.y+0.2 + 0.75*sin(-fireAim+0.5), fireAim);
+    }
+  }
+
+  timer.lap(PROF_SIM_BULLETS);
+
+  catchBricks(bricks[BRICK_RED], basket1, score, hitMask);
+  catchBricks(bricks[BRICK_GREEN], basket2, score, hitMask);
+  timer.lap(PROF_SIM_CATCH);
+
+  for(int c=0;c<BRICK_COLORS;c++)
+  {
+    BrickPool &p = bricks[c];
+    for (int i=0;i<p.size();)
+    {
+      p.y[i] = p.y[i]-config.fallSpeed*k;
+      if(p.y[i] < -4) // fell past the baskets
+        p.remove(i);
+      else
+        i++;
+    }
+    if(config.liveBricks > 0)
+    {
+      // Top up to an even share, the first colours taking the remainder
+      // so the shares add up to liveBricks. Spread over the field the
+      // first time so the whole population doesn't fall in lockstep
+      Pcg32 &rng = spawnRng[c];
+      int share = config.liveBricks/BRICK_COLORS + (c < config.liveBricks%BRICK_COLORS);
+      while(p.size() < share)
+        p.spawn(-1 + 6*(rng.next()/4294967296.0), tick == 1 ? -4 + 8*(rng.next()/4294967296.0) : 4);
+    }
+    else if(time - lastSpawn[c] >= config.spawnInterval)
+    {
+      lastSpawn[c] = time;
+      for (int b=0;b<config.spawnBurst;b++)
+        p.spawn((int)spawnRng[c].below(7) - 1, 4);
+    }
+  }
+  timer.lap(PROF_SIM_BRICKS);
+}
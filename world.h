@@ -0,0 +1,107 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <vector>
+#include <stdint.h>
+#include "grid.h"
+#include "rng.h"
+
+/* Gameplay state and rules for Falling Blocks.
+   Nothing in here touches OpenGL or GLFW, so the game can be ticked
+   without a window or a GL context. draw() only reads from it. */
+
+struct Vec2 {
+  float x, y;
+};
+
+enum BrickColor { BRICK_RED, BRICK_GREEN, BRICK_BLACK, BRICK_COLORS };
+
+/* Pools are packed densely: removing an entity moves the last one into
+   its place, so loops only ever touch live entities. Nothing outside a
+   step holds on to an index, so no handles are needed. Capacity is kept
+   after removal, so a long session reuses the same memory */
+
+/* One colour of brick, structure-of-arrays. py is y before the last step */
+struct BrickPool {
+  std::vector<float> x, y, py;
+
+  int size() const { return x.size(); }
+  void spawn(float x0, float y0);
+  void remove(int i);
+};
+
+struct BulletPool {
+  std::vector<float> x, y, px, py;
+  std::vector<double> rot;
+
+  int size() const { return x.size(); }
+  void spawn(float x0, float y0, double angle);
+  void remove(int i);
+};
+
+/* Tunables for spawning and speeds, so the game can be pushed well past
+   what normal play produces. Speeds are per 60 Hz frame, like the rest
+   of the game's numbers */
+struct WorldConfig {
+  double spawnInterval; // seconds between spawns of each colour
+  int spawnBurst;       // bricks per spawn
+  double fallSpeed;     // brick fall per frame
+  double bulletSpeed;   // bullet travel along x per frame
+  double fireInterval;  // turret cooldown in seconds
+  int liveBricks;       // if above zero, keep this many bricks alive instead
+
+  WorldConfig();
+};
+
+struct World {
+  Vec2 basket1;   // red basket
+  Vec2 basket2;   // green basket
+  Vec2 turret;    // bottom-left corner of the turret rectangle
+  Vec2 mirror;
+
+  double aim;     // gun angle, follows the cursor
+  double fireAim; // gun angle when space was last pressed
+  bool fireRequested;
+
+  float score;
+  double time;    // simulated seconds since start
+  uint32_t tick;  // steps taken since start
+
+  BrickPool bricks[BRICK_COLORS];
+  WorldConfig config;
+  Pcg32 spawnRng[BRICK_COLORS];  // one stream per colour, drawn only on a spawn
+  double lastSpawn[BRICK_COLORS];
+
+  BulletPool bullets;
+  double bullet_time;
+  int reflected;  // bullets the mirror turned in the last step
+
+  Grid blackGrid;                // broadphase over black bricks for bullets
+  std::vector<unsigned char> shot; // scratch: black bricks hit this step
+  std::vector<uint64_t> hitMask;   // scratch for overlapBoxes()
+
+  // Broadphase counters since start: pairs the grid handed to the
+  // narrowphase, and how many of those actually collided
+  long long candidatePairs, hitPairs;
+
+  // Time the phases of each step into the profiler (PROF_SIM_*). Off by
+  // default, so benchmarks and replays read no clocks
+  bool profilePhases;
+
+  World();
+
+  /* Same seed, same bricks: each colour gets its own stream of it */
+  void seed(uint64_t s);
+
+  /* Advance the simulation by dt seconds. The positions from before the
+     step are kept in the p* arrays so the renderer can interpolate */
+  void step(double dt);
+
+  /* Player input */
+  void fire(double angle);
+  void moveBasket1(float dx);
+  void moveBasket2(float dx);
+  void moveTurret(float dy);
+};
+
+#endif